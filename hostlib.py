@@ -0,0 +1,142 @@
+########################################################################
+## PIC ADI Host Library Builder
+##
+## Author: Michael R. Shannon
+##
+## Used by the host tools (replay, efisgold) to compile firmware
+## sources unmodified into a shared library that can be called with
+## ctypes.  A small shim stands in for the PIC18 headers.  Firmware of
+## another git revision can be extracted with checkout.
+##
+## Libraries built with blocks=True count the basic blocks run in
+## hostBlocks, the same measure of work picsim turns into instruction
+## cycles (see sim/sim.h).
+##
+## NOTE: C18 does not promote integers to int, the host compiler does.
+##       Code that depends on 16-bit intermediate results can behave
+##       differently on the host.
+##
+########################################################################
+
+
+import ctypes
+import hashlib
+import os
+import subprocess
+import tempfile
+
+
+REPO = os.path.dirname(os.path.abspath(__file__))
+
+
+# Host stand-in for the PIC18 register header, only what the portable
+# parts of the firmware and the pins of src/imu.c touch.
+SHIM_HEADER = """\
+#ifndef P18CXXX_H
+#define P18CXXX_H
+#include <stdint.h>
+#define STDINT_H
+typedef int32_t int24_t;
+typedef uint32_t uint24_t;
+#define rom
+#define far
+#define near
+struct intconBits { unsigned GIE : 1; unsigned GIEL : 1; };
+struct intcon2Bits { unsigned INTEDG2 : 1; };
+struct intcon3Bits { unsigned INT2IF : 1; unsigned INT2IE : 1;
+                     unsigned INT2IP : 1; };
+struct trisBBits { unsigned TRISB2 : 1; };
+struct trisHBits { unsigned TRISH0 : 1; unsigned TRISH3 : 1;
+                   unsigned TRISH4 : 1; unsigned TRISH5 : 1;
+                   unsigned TRISH6 : 1; };
+struct latHBits { unsigned LATH0 : 1; unsigned LATH3 : 1;
+                  unsigned LATH4 : 1; unsigned LATH5 : 1;
+                  unsigned LATH6 : 1; };
+extern struct intconBits INTCONbits;
+extern struct intcon2Bits INTCON2bits;
+extern struct intcon3Bits INTCON3bits;
+extern struct trisBBits TRISBbits;
+extern struct trisHBits TRISHbits;
+extern struct latHBits LATHbits;
+#endif
+"""
+
+
+# Definitions of the registers in SHIM_HEADER.
+SHIM_REGISTERS = """\
+struct intconBits INTCONbits;
+struct intcon2Bits INTCON2bits;
+struct intcon3Bits INTCON3bits;
+struct trisBBits TRISBbits;
+struct trisHBits TRISHbits;
+struct latHBits LATHbits;
+"""
+
+
+# Basic block counter of libraries built with blocks=True.
+BLOCKS_GLUE = """\
+uint32_t hostBlocks;
+__attribute__((no_sanitize_coverage))
+void __sanitizer_cov_trace_pc(void){
+    ++hostBlocks;
+}
+"""
+
+
+# Instruction cycles per basic block, the picsim default.
+BLOCK_CYCLES = 8
+
+
+def build(name, sources, glue, tree=REPO, cc=None, blocks=False):
+    """Compile <sources> (relative to <tree>) and the C source <glue>
+    into a host library, reusing it if up to date.  With <blocks> the
+    sources count the basic blocks they run in hostBlocks."""
+    cc = cc or os.environ.get("CC", "cc")
+    key = hashlib.sha1(os.path.abspath(tree).encode()).hexdigest()[:8]
+    out = os.path.join(tempfile.gettempdir(), "picadi-host", key)
+    shim = os.path.join(out, "shim")
+    os.makedirs(shim, exist_ok=True)
+    glue = SHIM_REGISTERS + glue
+    flags = []
+    if blocks:
+        glue = BLOCKS_GLUE + glue
+        flags = ["-fsanitize-coverage=trace-pc"]
+    for filename, text in (("p18cxxx.h", SHIM_HEADER), ("delays.h", ""),
+                           (name + ".c", '#include <p18cxxx.h>\n' + glue)):
+        path = os.path.join(shim, filename)
+        if not os.path.exists(path) or open(path).read() != text:
+            with open(path, "w") as f:
+                f.write(text)
+
+    library = os.path.join(out, "lib{}.so".format(name))
+    inputs = [os.path.join(tree, s) for s in sources]
+    inputs.append(os.path.join(shim, name + ".c"))
+    depends = list(inputs)
+    for root, _, files in os.walk(os.path.join(tree, "include")):
+        depends += [os.path.join(root, f) for f in files]
+    if (not os.path.exists(library) or
+            max(os.path.getmtime(f) for f in depends) >
+            os.path.getmtime(library)):
+        # The repo's stdint.h and stdbool.h use C18 types, so the
+        # include directory is searched after the system headers.
+        subprocess.check_call(
+            [cc, "-O2", "-shared", "-fPIC", "-I", shim,
+             "-idirafter", os.path.join(tree, "include"),
+             "-o", library] + flags + inputs)
+    return ctypes.CDLL(library)
+
+
+def checkout(rev):
+    """Extract src and include of a git revision, return the tree."""
+    sha = subprocess.check_output(
+        ["git", "-C", REPO, "rev-parse", rev]).decode().strip()
+    tree = os.path.join(tempfile.gettempdir(), "picadi-host", "rev-" + sha)
+    if not os.path.isdir(tree):
+        os.makedirs(tree)
+        archive = subprocess.Popen(
+            ["git", "-C", REPO, "archive", sha, "src", "include"],
+            stdout=subprocess.PIPE)
+        subprocess.check_call(["tar", "-x", "-C", tree],
+                              stdin=archive.stdout)
+        archive.wait()
+    return tree
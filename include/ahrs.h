@@ -28,6 +28,17 @@
 #define AHRS_H
 
 
+// Attitude solution, along with the trig functions of roll so they do
+// not have to be recomputed by the EFIS.
+struct attitude {
+    int16_t yaw;        // heading, 0 to 360 degrees in TRIG16 units
+    int16_t pitch;      // pitch, -90 to +90 degrees in TRIG16 units
+    int16_t roll;       // roll, -180 to 180 degrees in TRIG16 units
+    int16_t rollSin;    // sine of roll, scaled to TRIG16_ONE
+    int16_t rollCos;    // cosine of roll, scaled to TRIG16_ONE
+};
+
+
 // Description:
 //      Compute a new attitude and heading solution from the IMU buffers.
 //
@@ -50,6 +61,23 @@
 bool ahrsUpdate(int16_t *yaw, int16_t *pitch, int16_t *roll);
 
 
+// Description:
+//      Alternative to ahrsUpdate that solves the same boxcar filtered
+//      measurement without sin16/cos16.  The trig functions of roll and
+//      pitch fall directly out of the normalized gravity vector, and the
+//      ones of roll are kept in the solution so the EFIS does not need
+//      them either.
+//
+// Input:
+//      struct attitude *att:
+//          Pointer to store attitude solution in.
+//
+// Output (bool):
+//      True if the solution is valid, see ahrsUpdate.
+//
+bool ahrsUpdate_(struct attitude *att);
+
+
 // Description:
 //      Read accelerometer data and filter with backwards looking
 //      boxcar filter over entire buffer (0.25 seconds).
@@ -71,6 +99,9 @@ void ahrsReadAcc(int16_t *x_ptr, int16_t *y_ptr, int16_t *z_ptr);
 //      Read magnetometer data and filter with backwards looking
 //      boxcar filter over entire buffer (0.25 seconds).
 //
+//      The result is corrected with the magnetometer calibration (see
+//      magcal.h).
+//
 // Input:
 //      int16_t *x_ptr:
 //          Point to store x-component of magnetic field.
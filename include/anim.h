@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////
+// File: anim.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Plays full screen animations stored in ROM by im2c into the
+//      frame buffer and writes the changed part of each frame to the
+//      OLED.
+//
+//      An animation is a series of frames, each a keyframe or a delta
+//      from the frame before.  Both are in frame buffer order (column
+//      major) and start with a tag byte:
+//
+//          ANIM_KEY    The whole frame run length encoded as the splash
+//                      is (see im2c), written with oledWriteBuffer.
+//
+//          ANIM_DELTA  Runs of a skip byte, a count byte and count bytes
+//                      to XOR into the frame buffer, ended by a skip and
+//                      count of zero.  Only the columns and pages the
+//                      runs touch are written, with oledWriteRows.
+//
+//      The first frame is always a keyframe.  animStep shows a frame
+//      once the period of the animation has passed since the last one
+//      (see schedTicks), so it can be called more often, for instance
+//      from the background task.  Anything drawn over the frame buffer
+//      between steps is left by deltas, so only draw over the areas
+//      the animation does not change.
+//
+//      Each frame shown calls scrollInvalidate, so the first EFIS
+//      frame after an animation is written whole.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef ANIM_H
+#define ANIM_H
+
+
+// Frame tags.
+#define ANIM_KEY 0
+#define ANIM_DELTA 1
+
+
+// An animation generated by im2c.
+struct animation {
+    uint8_t frames;             // number of frames
+    uint8_t period;             // milliseconds between frames
+    const rom uint8_t *data;    // frames
+};
+
+
+// Description:
+//      Start an animation, the next step shows its first frame.
+//
+// Input:
+//      const rom struct animation *anim:
+//          Animation to play.
+//
+void animStart(const rom struct animation *anim);
+
+
+// Description:
+//      Once the animation period has passed since the last frame,
+//      decode the next frame into the frame buffer and write what
+//      changed to the OLED.
+//
+// Output (bool):
+//      True if a frame was shown.  False if it is not time yet or the
+//      animation has ended (see animPlaying), nothing is done.
+//
+bool animStep(void);
+
+
+// Description:
+//      Check whether the animation has frames left.
+//
+// Output (bool):
+//      True until the last frame has been shown.
+//
+bool animPlaying(void);
+
+
+#endif // ANIM_H
@@ -18,5 +18,66 @@
 // #define PLLMUL 1
 #define PLLMUL 4
 
+// Solve the attitude with ahrsUpdate_, which takes the trig functions of
+// roll and pitch from the gravity vector and hands the ones of roll to
+// the EFIS, instead of ahrsUpdate.  Its 32-bit divides and square roots
+// cost more on the PIC18 than the sin16/cos16 calls they save, so it is
+// off.  Uncomment to use ahrsUpdate_.
+// #define AHRS_CACHED_TRIG
+
+// Pass IMU samples through a sliding median (see imu.h) before they are
+// stored in the IMU buffers.  This removes vibration spikes before they
+// reach the boxcar filter.  Comment out to store raw samples.
+#define IMU_MEDIAN_FILTER
+
+// Scheduler task periods in milliseconds.  The AHRS runs at the IMU
+// data rate (100 Hz) and the EFIS is rendered at 25 frames per second.
+#define AHRS_PERIOD 10
+#define RENDER_PERIOD 40
+
+// Period in milliseconds of the task that polls the magnetometer
+// calibration button (see picadi.c), long enough to debounce it.
+#define MAGCAL_PERIOD 50
+
+// Milliseconds of each render period that drawing and writing the EFIS
+// may take, the rest is left for the other tasks.  Optional EFIS layers
+// are turned off while frames run over this budget.
+#define RENDER_BUDGET 30
+
+// Time sections of the main loop with timer 1 and show the report on
+// the OLED in place of the EFIS (see profile.h).  Comment out to compile
+// the profiling code out.
+// #define PROFILE
+
+// Stream telemetry over EUSART1 (see telemetry.h).  The channels sent
+// are selected by TELEMETRY_CHANNELS and the task runs every
+// TELEMETRY_PERIOD milliseconds.  Comment out to turn telemetry off.
+#define TELEMETRY
+#define TELEMETRY_CHANNELS \
+    (TLM_CHANNEL(TLM_ATTITUDE) | TLM_CHANNEL(TLM_STATUS))
+#define TELEMETRY_PERIOD 10
+
+// Scroll wings level EFIS frames with the OLED start line and write
+// only the rows that changed (see scroll.h), frames within half a pixel
+// of wings level are drawn level.  Not used with PROFILE.  Comment out
+// to always write whole frames.
+#define EFIS_SCROLL
+
+// Keep the horizon of the last frame when it has not moved and only
+// erase and redraw the inverted overlays (see efisInvalidate).  Comment
+// out to draw every frame whole.
+#define EFIS_XOR_UNDO
+
+// Record raw IMU samples and attitude solutions to the SD card (see
+// recorder.h).  Card writes are done by the background task.  Comment
+// out to turn the recorder off.
+#define RECORDER
+
+// Trace every SPI transaction into a RAM ring (see spitrace.h) and send
+// it on the TLM_SPI_TRACE telemetry channel, which must be added to
+// TELEMETRY_CHANNELS.  Uses timer 1 like the profiler.  Comment out to
+// compile the tracing out.
+// #define SPI_TRACE
+
 #endif // CONFIG_H
 
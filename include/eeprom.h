@@ -8,12 +8,22 @@
 // Description:
 //      This library is used to talk to the 25AA128-I/P EEPROM chip.
 //
-//      This library currently contains only the minimum macros needed
-//      to unselect the chip.
+//      The EEPROM shares SPI1 with the IMU.  Each transaction is run
+//      with interrupts disabled so the IMU interrupt cannot use the bus
+//      while the EEPROM is selected.  SPI1 must already be initialized
+//      (see imuInit).
+//
+//      A write cycle takes about 5 ms.  eepromWritePage starts one and
+//      returns, use eepromBusy to check when it is done.  Every other
+//      access waits for a write cycle in progress to finish first.
 //
 ////////////////////////////////////////////////////////////////////////
 
 
+#include "stdint.h"
+#include "stdbool.h"
+
+
 #ifndef EEPROM_H
 #define EEPROM_H
 
@@ -24,4 +34,70 @@
 #define EPM_DESELECT() (LATHbits.LATH4 = 1)
 
 
+// EEPROM geometry.
+#define EPM_SIZE 16384      // in bytes
+#define EPM_PAGE_SIZE 64    // write page size in bytes
+
+
+// Description:
+//      Read bytes from the EEPROM.
+//
+// Input:
+//      uint16_t address:
+//          EEPROM address to start reading at.
+//
+//      uint8_t *buf:
+//          Buffer to store the read bytes in.
+//
+//      uint8_t len:
+//          Number of bytes to read.
+//
+void eepromRead(uint16_t address, uint8_t *buf, uint8_t len);
+
+
+// Description:
+//      Write bytes to the EEPROM.  Writes are split on page boundaries
+//      and this function busy waits (with interrupts enabled) for each
+//      page write to finish, about 5 ms per page.
+//
+// Input:
+//      uint16_t address:
+//          EEPROM address to start writing at.
+//
+//      const uint8_t *buf:
+//          Buffer of bytes to write.
+//
+//      uint8_t len:
+//          Number of bytes to write.
+//
+void eepromWrite(uint16_t address, const uint8_t *buf, uint8_t len);
+
+
+// Description:
+//      Start writing bytes within one page of the EEPROM, without
+//      waiting for the write cycle to finish.
+//
+// Input:
+//      uint16_t address:
+//          EEPROM address to start writing at.
+//
+//      const uint8_t *buf:
+//          Buffer of bytes to write.
+//
+//      uint8_t len:
+//          Number of bytes to write, they must not cross a page
+//          boundary (EPM_PAGE_SIZE).
+//
+void eepromWritePage(uint16_t address, const uint8_t *buf, uint8_t len);
+
+
+// Description:
+//      Check if the EEPROM is still in a write cycle.
+//
+// Output (bool):
+//      True if the EEPROM is busy.
+//
+bool eepromBusy(void);
+
+
 #endif // EEPROM_H
@@ -21,6 +21,46 @@
 #define EFIS_H
 
 
+// Optional layers, can be turned off in efisLayers to save time.
+#define EFIS_LAYER_PITCH_FINE 0b00000001    // 5 degree pitch lines
+#define EFIS_LAYER_ROLL_FINE 0b00000010     // 10, 20 and 45 degree ticks
+#define EFIS_LAYER_INVALID_CROSS 0b00000100 // crosses in invalid boxes
+#define EFIS_LAYERS_ALL 0b00000111
+
+
+// Optional layers that are drawn, all by default.
+extern uint8_t efisLayers;
+
+
+// What the last efisDraw drew, used to send only what changed (see
+// scroll.h).
+struct efisFrame {
+    int16_t pitch;      // pixels the horizon is drawn below the center
+    int16_t heading;    // compass heading in degrees
+    uint8_t layers;     // efisLayers
+    bool level;         // drawn at zero roll
+    bool invalid;       // invalid boxes drawn
+};
+extern struct efisFrame efisFrame;
+
+
+// A screen area in GL coordinates, the vertical coordinates can be off
+// the frame buffer.
+struct efisBox {
+    uint8_t x0, x1;
+    int8_t y0, y1;
+};
+
+
+// Overlays of a wings level frame, the compass is first.
+#define EFIS_OVERLAY_COMPASS 0
+#define EFIS_OVERLAYS 16
+
+
+// Most pitch lines drawn.
+#define EFIS_PITCH_LINES 6
+
+
 // Description:
 //      Draw the entire EFIS to the frame buffer.  This is everything
 //      that is drawn to the OLED display.
@@ -42,9 +82,64 @@
 void efisDraw(int16_t yaw, int16_t pitch, int16_t roll, bool valid);
 
 
+// Same as efisDraw but uses the given trig functions of roll instead of
+// computing them.
+//
+// NOTE: With EFIS_SCROLL rolls that move the horizon less than half a
+//       pixel at the edges of the screen are drawn as zero roll.
+void efisDraw_(int16_t yaw, int16_t pitch,
+               int16_t rollSin, int16_t rollCos, bool valid);
+
+
+// Description:
+//      With EFIS_XOR_UNDO efisDraw only draws the whole EFIS when the
+//      horizon moves by a pixel.  Otherwise the frame buffer is taken
+//      to hold the last frame, the inverted overlays that moved are
+//      drawn again to erase them and then drawn at their new place.
+//      Call this after drawing anything else to the frame buffer so the
+//      next frame is drawn whole.  After writing anything else to the
+//      OLED call scrollInvalidate as well.
+//
+void efisInvalidate(void);
+
+
+// Description:
+//      Get the areas of a wings level frame that are fixed to the screen
+//      while the horizon and pitch lines move with pitch: the compass,
+//      the plane symbol, the bank pointer and each bank tick.
+//
+// Input:
+//      struct efisBox boxes[EFIS_OVERLAYS]:
+//          Array to return the areas in.
+//
+void efisOverlays(struct efisBox boxes[EFIS_OVERLAYS]);
+
+
+// Description:
+//      Get the areas of the pitch lines of a wings level frame, in the
+//      order efisDrawPitch draws them.
+//
+// Input:
+//      int16_t pitch:
+//          Pixels the horizon is drawn below the center (see efisFrame).
+//
+//      uint8_t layers:
+//          Optional layers drawn.
+//
+//      struct efisBox boxes[EFIS_PITCH_LINES]:
+//          Array to return the areas in.
+//
+// Output (uint8_t):
+//      Number of pitch lines.
+//
+uint8_t efisPitchLines(int16_t pitch, uint8_t layers,
+                       struct efisBox boxes[EFIS_PITCH_LINES]);
+
+
 // Description:
 //      Draw invalid boxes on either side of the screen if <valid> is
-//      false.
+//      false.  The boxes are crossed out if EFIS_LAYER_INVALID_CROSS is
+//      set.
 //
 // Input:
 //      bool valid:
@@ -79,6 +174,11 @@ void efisDrawCompass(int16_t yaw);
 void efisDrawAI(int16_t pitch, int16_t roll);
 
 
+// Same as efisDrawAI but uses the given trig functions of roll instead
+// of computing them.
+void efisDrawAI_(int16_t pitch, int16_t rollSin, int16_t rollCos);
+
+
 // Description:
 //      Draw plane symbol.  Consists of a circle, vertical line, and two
 //      horizontal lines about the center of the frame buffer.
@@ -87,7 +187,8 @@ void efisDrawPlane(void);
 
 
 // Description:
-//      Draw pitch lines at 5 and 10 degree increments.
+//      Draw pitch lines at 5 and 10 degree increments.  The 5 degree
+//      lines are only drawn if EFIS_LAYER_PITCH_FINE is set.
 //
 // Input:
 //      int16_t pitch:
@@ -105,33 +206,27 @@ void efisDrawPitch(int16_t pitch, int16_t rollSin, int16_t rollCos);
 // Description:
 //      Draw bank indicator.  Consists of a single pointer triangle and
 //      bank lines and 0, 10, 20, 30,45, 60 and 90 degrees (as well as
-//      their inverses).
+//      their inverses).  The 10, 20 and 45 degree lines are only drawn
+//      if EFIS_LAYER_ROLL_FINE is set.
 //
 // Input:
-//      int16_t roll:
-//          Roll (positive clockwise) from -180 to 180 degrees in TRIG16
-//          units.
-//
-void efisDrawRoll(int16_t roll);
-
-
-// Description:
-//      Draw a single bank indicator line of given length and angle to
-//      the frame buffer.
-//
-//  Input:
-//      int16_t theta:
-//          Rotation angle bank indicator line.
+//      int16_t rollSin:
+//          Sine of roll angle.  Scaled from zero to TRIG16_ONE.
 //
-//      uint8_t length:
-//          Length of bank indicator line in pixels.
+//      int16_t rollCos:
+//          Cosine of roll angle.  Scaled from zero to TRIG16_ONE.
 //
-void efisDrawRollLine(int16_t theta, uint8_t length);
+void efisDrawRoll(int16_t rollSin, int16_t rollCos);
 
 
 // Description:
 //      Draw artificial horizon to the frame buffer.
 //
+//      The horizon line and polygon of the last call are reused when
+//      the pitch in pixels and the trig functions of roll are the same,
+//      and the clipped line and polygon when the rotated line lands on
+//      the same pixels.
+//
 // Input:
 //      int16_t pitch:
 //          Pitch from -90 to 90 degrees in TRIG16 units.
@@ -221,23 +316,4 @@ int8_t efisPoints(uint8_t xa[], uint8_t ya[],
                   int16_t x1, int16_t y1);
 
 
-// Description:
-//      Draw artificial horizon where the drawn polygon requires a 4
-//      point polygon.
-//
-// Input:
-//      uint8_t xa[4]:
-//          Horizontal coordinates of the points of the drawn polygon.
-//          Horizon line is given first.
-//
-//      uint8_t ya[4]:
-//          Vertical coordinates of the points of the drawn polygon.
-//          Horizon line is given first.
-//
-//      uint8_t color:
-//          Color (defined only).
-//
-void efisDrawHorizonAsPolygon(uint8_t xa[4], uint8_t ya[4], uint8_t color);
-
-
 #endif // EFIS_H
@@ -53,12 +53,48 @@
 #define GL_CCL 0b00000001   // left
 
 
+// Most vertices of a polygon.
+#define GL_POLYGON_MAX 8
+
+
 // ASCII character constants.
 #define GL_NUM_CHARS 96     // characters in ASCII table
 #define GL_CHAR_WIDTH 6     // pixel width of each character
 #define GL_CHAR_HEIGHT 8    // pixel height of each character
 
 
+// Sprite flags.
+#define GL_SPRITE_RLE 0x01  // data is run length encoded
+
+
+// A bitmap with its size and anchor, usually generated by im2c.  The
+// data is column major with (height + 7)/8 bytes per column and bit 0
+// of a byte at the top, the order of the frame buffer.  Run length
+// encoded data is a series of packets over the whole bitmap, a control
+// byte of 0x80 | (n - 1) followed by one byte repeated n times or a
+// control byte of n - 1 followed by n literal bytes.
+struct glSprite {
+    uint8_t width;              // pixel width
+    uint8_t height;             // pixel height
+    int8_t xOffset;             // anchor, pixels right of the left edge
+    int8_t yOffset;             // anchor, pixels below the top edge
+    uint8_t flags;              // GL_SPRITE_* flags
+    const rom uint8_t *data;    // bitmap
+};
+
+
+// A fixed width font generated by im2c.  Glyphs are stored one after
+// another in the sprite layout without compression and include the
+// spacing between characters.
+struct glFont {
+    uint8_t width;              // pixel width of each glyph
+    uint8_t height;             // pixel height of each glyph
+    uint8_t first;              // ASCII code of the first glyph
+    uint8_t count;              // number of glyphs
+    const rom uint8_t *data;    // glyphs
+};
+
+
 // Description:
 //      Set frame buffer to all white.
 //
@@ -256,7 +292,8 @@ void glRectFill_(uint8_t x0, uint8_t y0,
 
 // Description:
 //      Draw a non-filled ellipse to the frame buffer using the
-//      Bresenham algorithm.
+//      Bresenham algorithm.  An ellipse entirely on the frame buffer is
+//      drawn without clipping each pixel.
 //
 //      Algorithm:
 //      http://members.chello.at/~easyfilter/bresenham.html
@@ -303,6 +340,51 @@ void glEllipse(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr, uint8_t color);
 void glCircle(int16_t xc, int16_t yc, uint8_t r, uint8_t color);
 
 
+// Description:
+//      Draw a filled ellipse to the frame buffer, covering the pixels of
+//      glEllipse and the ones between them.  The Bresenham algorithm of
+//      glEllipse gives the height of each column and the columns are
+//      drawn as vertical lines, mirrored about the center.
+//
+// Input:
+//      int16_t xc:
+//          Horizontal coordinate of center.
+//
+//      int16_t yc:
+//          Vertical coordinate of center.
+//
+//      uint8_t xr:
+//          Horizontal radius in pixels.
+//
+//      uint8_t yr:
+//          Vertical radius in pixels.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+void glEllipseFill(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr,
+                   uint8_t color);
+
+
+// Description:
+//      Draw a filled circle to the frame buffer, see glEllipseFill.
+//
+// Input:
+//      int16_t xc:
+//          Horizontal coordinate of center.
+//
+//      int16_t yc:
+//          Vertical coordinate of center.
+//
+//      uint8_t r:
+//          Radius in pixels.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+void glCircleFill(int16_t xc, int16_t yc, uint8_t r, uint8_t color);
+
+
 // Description:
 //      Draw a non-filled triangle to the frame buffer.
 //
@@ -335,11 +417,7 @@ void glTriangle(int16_t x0, int16_t y0,
 
 
 // Description:
-//      Draw a filled triangle to the frame buffer.
-//
-//      Triangle rasterization algorithm from:
-//      http://www.sunshine2k.de/coding/java/TriangleRasterization/
-//          TriangleRasterization.html#algo3
+//      Draw a filled triangle to the frame buffer with glPolygonFill.
 //
 // Input:
 //      int16_t x0:
@@ -370,6 +448,10 @@ void glTriangleFill(int16_t x0, int16_t y0,
 // Same as glTriangleFill but cannot be used when a side of triangle is
 // vertical.  It also requires that the middle point (horizontally be
 // given last).
+//
+// Triangle rasterization algorithm from:
+// http://www.sunshine2k.de/coding/java/TriangleRasterization/
+//     TriangleRasterization.html#algo3
 void glTriangleFill_(int16_t x0, int16_t y0,
                      int16_t x1, int16_t y1,
                      int16_t xm, int16_t ym,
@@ -407,6 +489,36 @@ void glTriangleFillFVS(int16_t xs, int16_t ys0, int16_t ys1,
                        uint8_t color);
 
 
+// Description:
+//      Draw a filled convex polygon to the frame buffer, clipped to the
+//      frame buffer.  The upper and lower sides are walked a column at a
+//      time with the Bresenham algorithm, so they cover the pixels glLine
+//      draws from their left ends.  The span between them is written a
+//      byte at a time, runs of columns with the same span as one
+//      rectangle.  Every pixel is drawn once, so GL_COLOR_INVERT works.
+//
+//      NOTE: The vertices must be in order around the polygon (either
+//            direction).  Any other polygon is drawn wrong.  Columns
+//            off the frame buffer are still walked, so keep vertices
+//            within a few hundred pixels of it.
+//
+// Input:
+//      const int16_t xs[]:
+//          Horizontal coordinates of the vertices.
+//
+//      const int16_t ys[]:
+//          Vertical coordinates of the vertices.
+//
+//      uint8_t n:
+//          Number of vertices, 1 to GL_POLYGON_MAX.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+void glPolygonFill(const int16_t xs[], const int16_t ys[], uint8_t n,
+                   uint8_t color);
+
+
 // Description:
 //      Write single ASCII character to frame buffer.  At given line and
 //      pixel offset.
@@ -453,4 +565,80 @@ void glChar(uint8_t line, uint8_t column, char ch, uint8_t color);
 void glString(uint8_t line, uint8_t column, uint8_t color, const char *str);
 
 
+// Description:
+//      Draw a bitmap to the frame buffer at any pixel location, clipped
+//      to the frame buffer.  The bitmap is in the layout of struct
+//      glSprite without compression.
+//
+// Input:
+//      int16_t x:
+//          Horizontal coordinate of the left edge.
+//
+//      int16_t y:
+//          Vertical coordinate of the top edge.
+//
+//      uint8_t width:
+//          Pixel width of the bitmap.
+//
+//      uint8_t height:
+//          Pixel height of the bitmap.
+//
+//      const rom uint8_t *data:
+//          Column major bitmap.
+//
+//      uint8_t color:
+//          Color, GL_COLOR_OVERWRITE replaces the whole rectangle.
+//
+void glBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height,
+              const rom uint8_t *data, uint8_t color);
+
+
+// Description:
+//      Draw a sprite to the frame buffer with its anchor at the given
+//      location, clipped to the frame buffer.
+//
+// Input:
+//      int16_t x:
+//          Horizontal coordinate of the anchor.
+//
+//      int16_t y:
+//          Vertical coordinate of the anchor.
+//
+//      const rom struct glSprite *sprite:
+//          Sprite to draw, compressed or not.
+//
+//      uint8_t color:
+//          Color, GL_COLOR_OVERWRITE replaces the whole rectangle.
+//
+void glSprite(int16_t x, int16_t y, const rom struct glSprite *sprite,
+              uint8_t color);
+
+
+// Description:
+//      Write a null terminated RAM char string to the frame buffer in a
+//      font generated by im2c at any pixel location.  A '\n' starts a
+//      new line below the first and characters outside the font are
+//      drawn as its last glyph.  Nothing wraps, characters are clipped
+//      to the frame buffer.
+//
+// Input:
+//      int16_t x:
+//          Horizontal coordinate of the left edge of the first glyph.
+//
+//      int16_t y:
+//          Vertical coordinate of the top edge of the first glyph.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+//      const rom struct glFont *font:
+//          Font to write with.
+//
+//      const char *str:
+//          Null terminated string to write to the frame buffer.
+//
+void glText(int16_t x, int16_t y, uint8_t color,
+            const rom struct glFont *font, const char *str);
+
+
 #endif // GRAPHICS_H
@@ -14,7 +14,9 @@
 ////////////////////////////////////////////////////////////////////////
 
 
+#include "config.h"
 #include "stdint.h"
+#include "stdbool.h"
 #include "util.h"
 #include "spilib.h"
 
@@ -38,6 +40,12 @@
 #define IMU_INT_FLAG (INTCON3bits.INT2IF)
 
 
+// Length of the sliding median used to reject outliers, must be odd.
+// The IMU samples pass through it when IMU_MEDIAN_FILTER is defined in
+// config.h, magnetometer calibration always uses it (see magcal.h).
+#define IMU_MEDIAN_LENGTH 5
+
+
 // IMU buffers.
 #define IMU_BUFFER_LENGTH 25
 extern uint8_t imuAccIdx;   // last written to buffer location (acceleration)
@@ -50,6 +58,23 @@ extern union bytes2 imuMagY[IMU_BUFFER_LENGTH];
 extern union bytes2 imuMagZ[IMU_BUFFER_LENGTH];
 
 
+// Number of samples of each sensor before the buffers hold a full
+// window of data, including the samples needed to fill the median.
+#ifdef IMU_MEDIAN_FILTER
+#define IMU_READY_SAMPLES (IMU_BUFFER_LENGTH + IMU_MEDIAN_LENGTH - 1)
+#else
+#define IMU_READY_SAMPLES IMU_BUFFER_LENGTH
+#endif
+
+
+// Sliding median window for a single axis, zero initialized.
+struct imuWindow {
+    int16_t sorted[IMU_MEDIAN_LENGTH];  // window in ascending order
+    int16_t history[IMU_MEDIAN_LENGTH]; // window in arrival order
+    uint8_t oldest;                     // index of oldest in history
+};
+
+
 // Description:
 //      Initialize accelerometer/magnetometer by setting up SPI module
 //      1, writing LSM303D initialization bytes, and setting up RB2 as
@@ -60,17 +85,55 @@ void imuInit(void);
 
 // Description:
 //      Finish initialization, must be called after interrupts are
-//      enabled.  This fixes the interrupt lock problem and preloads the
-//      buffers.
+//      enabled.  This fixes the interrupt lock problem.  The buffers
+//      fill under interrupts afterwards, use imuReady to check if they
+//      are full.
 //
 void imuSpinup(void);
 
 
+// Description:
+//      Check if the buffers hold a full window of data.
+//
+// Output (bool):
+//      True once IMU_READY_SAMPLES of both the accelerometer and the
+//      magnetometer have been received.
+//
+bool imuReady(void);
+
+
+// Description:
+//      Replace the oldest sample in a median window with a new sample
+//      and return the median of the window.  Used by imuISR on every
+//      axis if IMU_MEDIAN_FILTER is defined, by magcalSample and by the
+//      host tools (see replay).
+//
+//      The sorted window is never re-sorted.  The old sample is removed
+//      and the new one inserted by sliding the samples between them, so
+//      the cost is at most IMU_MEDIAN_LENGTH steps.
+//
+// Input:
+//      struct imuWindow *win:
+//          Median window of the axis.
+//
+//      int16_t sample:
+//          New sample.
+//
+// Output (int16_t):
+//      Median of the window after adding the new sample.
+//
+int16_t imuMedian(struct imuWindow *win, int16_t sample);
+
+
 // Description:
 //      Low priority IMU interrupt service routine.  Handles reading
 //      acceleration and magnetic field data from the LSM303D when data
 //      is available and loading it into the buffers.
 //
+//      If IMU_MEDIAN_FILTER is defined each sample is replaced by the
+//      median of the last IMU_MEDIAN_LENGTH samples of its axis.  This
+//      delays the data by IMU_MEDIAN_LENGTH/2 samples.
+//
 void imuISR(void);
 
 
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////
+// File: magcal.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      This library calibrates the magnetometer for hard iron (offset)
+//      and soft iron (per axis scale) errors of the installation.
+//
+//      To calibrate call magcalStart(), rotate the unit through as many
+//      orientations as possible, then call magcalFinish().  The
+//      calibration button starts and finishes it (see picadi.c).  While
+//      calibrating imuISR feeds each magnetometer sample to
+//      magcalSample().  Only the extremes of each axis are kept so no
+//      samples are stored.  The readings first pass through a sliding
+//      median (see imuMedian), so a reading has to hold for most of
+//      IMU_MEDIAN_LENGTH readings to become an extreme and a single
+//      outlier can not set the offset.
+//
+//      The coefficients are stored in the EEPROM and loaded by
+//      magcalInit().
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef MAGCAL_H
+#define MAGCAL_H
+
+
+#define MAGCAL_ONE 16384L           // scale treated as one
+#define MAGCAL_MIN_RADIUS 500       // minimum radius for a valid fit
+#define MAGCAL_EEPROM_ADDRESS 0x0000 // location of coefficients
+
+
+// Description:
+//      Load calibration coefficients from the EEPROM.  If no valid
+//      coefficients are stored no correction is applied.  Must be
+//      called after SPI1 has been initialized (see imuInit).
+//
+void magcalInit(void);
+
+
+// Description:
+//      Start gathering calibration samples.
+//
+void magcalStart(void);
+
+
+// Description:
+//      Add a magnetometer sample to the calibration.  Does nothing if
+//      calibration has not been started.  Only call from the low
+//      priority interrupt (see imuISR).
+//
+// Input:
+//      int16_t x, y, z:
+//          Uncorrected magnetometer sample.
+//
+void magcalSample(int16_t x, int16_t y, int16_t z);
+
+
+// Description:
+//      Stop calibration, compute the coefficients and store them in the
+//      EEPROM.
+//
+// Output (bool):
+//      True if the unit was rotated enough to compute a calibration.
+//      If false the previous calibration is kept.
+//
+bool magcalFinish(void);
+
+
+// Description:
+//      Check if calibration is in progress.
+//
+// Output (bool):
+//      True if calibration is in progress.
+//
+bool magcalActive(void);
+
+
+// Description:
+//      Apply the calibration to a magnetometer reading in place.  The
+//      corrected components saturate at the int16_t limits.
+//
+// Input:
+//      int16_t *x_ptr, *y_ptr, *z_ptr:
+//          Pointers to the components of the magnetometer reading.
+//
+void magcalApply(int16_t *x_ptr, int16_t *y_ptr, int16_t *z_ptr);
+
+
+#endif // MAGCAL_H
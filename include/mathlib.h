@@ -85,6 +85,7 @@ int16_t cos16(int16_t theta);
 //
 // Output (int32_t):
 //      Tangent of theta where -1 to +1 is scaled from -32767 to +32767.
+//      Saturates to +/-INT32_MAX at 90 and 270 degrees.
 //
 int32_t tan16(int16_t theta);
 
@@ -101,9 +102,25 @@ int32_t tan16(int16_t theta);
 //      int16_t x:
 //          x (horizontal) value
 //
+// Output (int16_t):
+//      Angle of (x, y) in TRIG16 units, 0 to TRIG16_MAX_ANGLE.
+//
 int16_t atan216(int16_t y, int16_t x);
 
 
+// Description:
+//      Integer square root.
+//
+// Input:
+//      uint32_t n:
+//          Number to take the square root of.
+//
+// Output (uint16_t):
+//      Square root of n rounded down.
+//
+uint16_t sqrt32(uint32_t n);
+
+
 // Description:
 //      Macro to convert integer angle in degrees to TRIG16 units.
 //
@@ -115,7 +132,7 @@ int16_t atan216(int16_t y, int16_t x);
 //      Angle in TRIG16 units.
 //
 #define fromDeg(theta) \
-    ((int16_t)(((int32_t)TRIG16_CYCLE)*((int32_t)theta)/360L))
+    ((int16_t)(((int32_t)TRIG16_CYCLE)*((int32_t)(theta))/360L))
 
 
 // Description:
@@ -128,7 +145,7 @@ int16_t atan216(int16_t y, int16_t x);
 // Output (int16_t):
 //      Angle in integer degrees.
 //
-#define toDeg(theta) (int16_t)(((int32_t)theta)*360L/TRIG16_CYCLE)
+#define toDeg(theta) ((int16_t)(((int32_t)(theta))*360L/TRIG16_CYCLE))
 
 
 // Description:
@@ -148,7 +165,7 @@ int16_t atan216(int16_t y, int16_t x);
 //          deg.
 //
 #define rotate16(xPtr, yPtr, theta) \
-    (rotate_(xPtr, yPtr, sin16(theta), cos16(theta)))
+    (rotate16_(xPtr, yPtr, sin16(theta), cos16(theta)))
 
 
 // Description:
@@ -172,6 +189,39 @@ int16_t atan216(int16_t y, int16_t x);
 void rotate16_(int16_t *xPtr, int16_t *yPtr,  int16_t s, int16_t c);
 
 
+// Description:
+//      Rotate an array of points by the angle given by sine and cosine
+//      values and then translate them.  Products are normalized with a
+//      rounding shift instead of a division.
+//
+// Input:
+//      int16_t xs[]:
+//          Array of x coordinate values, rotated in place.
+//
+//      int16_t ys[]:
+//          Array of y coordinate values, rotated in place.
+//
+//      uint8_t n:
+//          Number of points.
+//
+//      int16_t s
+//          Sine of angle to rotate about 0,0.  Scaled from zero to
+//          TRIG16_ONE.
+//
+//      int16_t c
+//          Cosine of angle to rotate about 0,0.  Scaled from zero to
+//          TRIG16_ONE.
+//
+//      int16_t cx:
+//          Value to add to each x coordinate after rotation.
+//
+//      int16_t cy:
+//          Value to add to each y coordinate after rotation.
+//
+void rotate16_batch(int16_t xs[], int16_t ys[], uint8_t n,
+                    int16_t s, int16_t c, int16_t cx, int16_t cy);
+
+
 // Description:
 //      Find x value on line corresponding to a given y value.
 //
@@ -200,6 +250,9 @@ void rotate16_(int16_t *xPtr, int16_t *yPtr,  int16_t s, int16_t c);
 // Description:
 //      Find y value on line corresponding to a given x value.
 //
+//      The product of x - x0 and y1 - y0 must fit in an int32_t, as it
+//      does when neither difference is over 46340.
+//
 // Input:
 //      int16_t x0:
 //          x coordinate of point 0.
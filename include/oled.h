@@ -19,6 +19,7 @@
 
 
 #include "stdint.h"
+#include "stdbool.h"
 
 
 #ifndef OLED_H
@@ -34,6 +35,68 @@
 #define OLED_SIZE (OLED_WIDTH * OLED_HEIGHT / 8) // total number of pixels
 
 
+////////////////////////////////////////////////////////////////////////
+// NOTE: Below are the bytes of the SSD1306 commands, see Table 9-1 of
+//       the SSD1306 OLED controller datasheet for details.  They are
+//       meant for ROM command tables sent with OLED_COMMANDS, e.g.
+//
+//       static const rom uint8_t dim[] = {
+//           OLED_CMD_CONTRAST(16),
+//           OLED_CMD_PRECHARGE_PERIOD(2, 2)
+//       };
+//       OLED_COMMANDS(dim);
+////////////////////////////////////////////////////////////////////////
+
+// Fundamental commands.
+#define OLED_CMD_CONTRAST(contrast) 0x81, (contrast)
+#define OLED_CMD_DISPLAY_RESUME() 0xA4
+#define OLED_CMD_DISPLAY_RESET() 0xA5
+#define OLED_CMD_DISPLAY_NORMAL() 0xA6
+#define OLED_CMD_DISPLAY_INVERSE() 0xA7
+#define OLED_CMD_DISPLAY_OFF() 0xAE
+#define OLED_CMD_DISPLAY_ON() 0xAF
+
+// Addressing commands, column and page ranges apply to the horizontal
+// and vertical addressing modes.
+#define OLED_HORIZONTAL_MODE 0b00
+#define OLED_VERTICAL_MODE 0b01
+#define OLED_PAGE_MODE 0b10
+#define OLED_CMD_ADDRESSING(mode) 0x20, (mode)
+#define OLED_CMD_COLUMN_RANGE(start, end) 0x21, (start), (end)
+#define OLED_CMD_PAGE_RANGE(start, end) 0x22, (start), (end)
+
+// Hardware configuration commands.
+#define OLED_CMD_START_LINE(line) (0b01000000 | ((line) & 0b00111111))
+#define OLED_CMD_NORMAL_COLUMN() 0xA0
+#define OLED_CMD_REVERSE_COLUMN() 0xA1
+#define OLED_CMD_MULTIPLEX(mux) 0xA8, ((mux) - 1)  // 16 <= mux <= 64
+#define OLED_CMD_NORMAL_ROW() 0xC0
+#define OLED_CMD_REVERSE_ROW() 0xC8
+#define OLED_CMD_VERTICAL_OFFSET(offset) 0xD3, (offset)  // 0 to 63
+#define OLED_ENABLE_ROW_REMAP 0b00100010
+#define OLED_DISABLE_ROW_REMAP 0b00000010
+#define OLED_SEQ_COM 0b00000010
+#define OLED_ALT_COM 0b00010010
+#define OLED_CMD_PIN_CONFIG(config) 0xDA, (config)
+
+// Timing and driving scheme commands, clock frequency (0-15) and
+// divisor (1-16), pre-charge periods in 1 to 15 display clock ticks.
+#define OLED_CMD_CLOCK(freq, div) \
+    0xD5, (((uint8_t)(freq)) << 4 | ((uint8_t)(div) - 1))
+#define OLED_CMD_PRECHARGE_PERIOD(phase1, phase2) \
+    0xD9, (((uint8_t)(phase2)) << 4 | ((uint8_t)(phase1)))
+#define OLED_CMD_VCOMH_065VCC() 0xDB, 0x00
+#define OLED_CMD_VCOMH_077VCC() 0xDB, 0x20
+#define OLED_CMD_VCOMH_083VCC() 0xDB, 0x30
+#define OLED_CMD_NOP() 0xE3
+
+// Charge pump commands (7.5 V).
+#define OLED_CMD_CHARGE_PUMP_ENABLE() 0x8D, 0x14
+#define OLED_CMD_CHARGE_PUMP_DISABLE() 0x8D, 0x10
+
+////////////////////////////////////////////////////////////////////////
+
+
 // Description:
 //      Initialize SPI2 and OLED display.
 //
@@ -41,11 +104,95 @@ void oledInit(void);
 
 
 // Description:
-//      Write the frame buffer to the OLED display.
+//      Write the frame buffer to the OLED display.  The whole display
+//      window is used and the start line is put back to 0.
 //
 void oledWriteBuffer(void);
 
 
+// Description:
+//      Send a table of command bytes, all in one chip select.
+//
+// Input:
+//      const rom uint8_t *table:
+//          Command bytes, see the OLED_CMD_* macros.
+//
+//      uint8_t length:
+//          Number of bytes in the table.
+//
+void oledCommands(const rom uint8_t *table, uint8_t length);
+
+
+// Description:
+//      Send a ROM command table array.
+//
+#define OLED_COMMANDS(table) oledCommands(table, sizeof(table))
+
+
+// Description:
+//      Set the contrast.
+//
+// Input:
+//      uint8_t contrast:
+//          Contrast from 0 to 255.
+//
+void oledContrast(uint8_t contrast);
+
+
+// Description:
+//      Set the addressing mode.  The frame buffer is laid out for
+//      OLED_VERTICAL_MODE which oledInit selects.
+//
+// Input:
+//      uint8_t mode:
+//          OLED_HORIZONTAL_MODE, OLED_VERTICAL_MODE or OLED_PAGE_MODE.
+//
+void oledAddressing(uint8_t mode);
+
+
+// Description:
+//      Set the window the following display data is written to.
+//
+// Input:
+//      uint8_t column0, column1:
+//          First and last column, 0 to 127.
+//
+//      uint8_t page0, page1:
+//          First and last page (8 pixel row), 0 to 7.
+//
+void oledWindow(uint8_t column0, uint8_t column1,
+                uint8_t page0, uint8_t page1);
+
+
+// Description:
+//      Set the display RAM line shown at the top row of the display,
+//      scrolling the image up by <line> rows.  oledWriteRows writes the
+//      frame buffer to match.
+//
+// Input:
+//      uint8_t line:
+//          Start line, 0 to 63.
+//
+void oledSetStartLine(uint8_t line);
+
+
+// Description:
+//      Write part of the frame buffer to the OLED display, as it is
+//      placed in display RAM by the start line.  A display RAM page
+//      straddles two frame buffer bytes unless the start line is a
+//      multiple of 8.
+//
+// Input:
+//      uint8_t column0, column1:
+//          First and last column, 0 to 127.
+//
+//      uint8_t page0, page1:
+//          First and last display RAM page (8 rows), 0 to 7.
+//
+void oledWriteRows(uint8_t column0, uint8_t column1,
+                   uint8_t page0, uint8_t page1);
+
+
 // Description:
 //      Switch display to normal mode.
 //
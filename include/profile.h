@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+// File: profile.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Section profiler.  Timer 1 free runs at Fosc/4 divided by
+//      PROFILE_PRESCALE and each section wrapped in PROFILE_BEGIN and
+//      PROFILE_END keeps the minimum, maximum, sum and count of its
+//      execution time in timer counts.
+//
+//      Sections must be shorter than one timer period (65536 counts,
+//      52 ms at the default 1:8 prescale and 40 MHz) and must not be
+//      nested within themselves.
+//
+//      The macros, the statistics and the functions using them compile
+//      to nothing unless PROFILE is defined in config.h.  profileInit
+//      and profileTime are always there, the SPI trace uses timer 1 too.
+//
+//      Host builds that define PROFILE_HOST_CLOCK (see sim/p18cxxx.h)
+//      time the sections with CLOCK_MONOTONIC in microseconds instead,
+//      so the same sections measure the firmware running on the host.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "config.h"
+#include "stdint.h"
+
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+
+// Timer 1 prescale (1, 2, 4 or 8).
+#ifndef PROFILE_PRESCALE
+#define PROFILE_PRESCALE 8
+#endif
+
+
+// Section identifiers.
+#define PROFILE_AHRS 0      // ahrsUpdate
+#define PROFILE_EFIS 1      // efisDraw, all of the following
+#define PROFILE_HORIZON 2   // efisDrawHorizon
+#define PROFILE_PITCH 3     // efisDrawPitch
+#define PROFILE_ROLL 4      // efisDrawRoll
+#define PROFILE_COMPASS 5   // efisDrawCompass
+#define PROFILE_OLED 6      // oledWriteBuffer
+#define PROFILE_SECTIONS 7
+
+
+// Statistics of a single section in timer counts.
+struct profileSection {
+    uint16_t start;     // timer value at PROFILE_BEGIN
+    uint16_t min;       // shortest time
+    uint16_t max;       // longest time
+    uint32_t sum;       // sum of all times
+    uint16_t count;     // number of times measured
+};
+
+
+// Section statistics, can be read with the debugger.
+extern struct profileSection profileSections[PROFILE_SECTIONS];
+
+
+// Description:
+//      Macros to mark the beginning and end of a section.
+//
+// Input:
+//      id:
+//          Section identifier.
+//
+#ifdef PROFILE
+#define PROFILE_BEGIN(id) (profileSections[id].start = profileTime())
+#define PROFILE_END(id) profileEnd(id)
+#else
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+#endif
+
+
+// Description:
+//      Macro to convert timer counts to microseconds.
+//
+// Input:
+//      counts:
+//          Timer counts.
+//
+// Output (uint32_t):
+//      Microseconds.
+//
+#ifdef PROFILE_HOST_CLOCK
+#define profileToUs(counts) ((uint32_t)(counts))
+#else
+#define profileToUs(counts) \
+    (((uint32_t)(counts))*(PROFILE_PRESCALE*10UL)/(25UL*PLLMUL))
+#endif
+
+
+// Description:
+//      Setup and start timer 1 and clear all statistics (with PROFILE).
+//
+void profileInit(void);
+
+
+// Description:
+//      Clear all statistics.
+//
+void profileClear(void);
+
+
+// Description:
+//      Read the free running timer.
+//
+// Output (uint16_t):
+//      Timer 1 count, or microseconds of CLOCK_MONOTONIC with
+//      PROFILE_HOST_CLOCK.
+//
+uint16_t profileTime(void);
+
+
+// Description:
+//      End a section, use PROFILE_END instead.
+//
+// Input:
+//      uint8_t id:
+//          Section identifier.
+//
+void profileEnd(uint8_t id);
+
+
+// Description:
+//      Draw the mean and maximum time in microseconds and the count of
+//      each section to the frame buffer.
+//
+void profileDraw(void);
+
+
+#endif // PROFILE_H
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////
+// File: recorder.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Flight data recorder.  Raw IMU samples (from the IMU interrupt)
+//      and attitude solutions are packed into RECORDER_BUFFER_SIZE byte
+//      buffers, each written to one 512 byte block of the SD card with
+//      the rest of the block zero.
+//
+//      Two buffers are used, each fills a 256 byte RAM bank.  Records
+//      are added to one while the other is written to the card by
+//      recorderTask, which never waits for the card.  If both buffers
+//      are full records are dropped and counted instead of stalling the
+//      IMU interrupt or the render.
+//
+//      The card is brought up by recorderTask a step at a time.  Each
+//      boot with a card starts a new session, the session number is kept
+//      in the EEPROM.  Session n is written to RECORDER_SESSION_BLOCKS
+//      blocks starting at block RECORDER_START_BLOCK +
+//      (n % RECORDER_SESSIONS)*RECORDER_SESSION_BLOCKS.  There is no
+//      file system, the card is read raw (see the replay script).
+//
+//      Block format (little endian):
+//
+//          uint8_t magic[2]        'R', 'L'
+//          uint16_t session        session number
+//          uint32_t sequence       block number within the session
+//          records...              until a zero type byte
+//
+//      Records all start with a type byte and a uint16_t millisecond
+//      timestamp (schedTicks):
+//
+//          RECORDER_ACC    int16_t x, y, z     raw accelerometer
+//          RECORDER_MAG    int16_t x, y, z     raw magnetometer
+//          RECORDER_ATT    int16_t yaw, pitch, roll; uint8_t valid
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+
+// Card layout.
+#define RECORDER_START_BLOCK 2048L      // leave the first 1 MB alone
+#define RECORDER_SESSION_BLOCKS 65536L  // 32 MB, over 1.5 hours
+#define RECORDER_SESSIONS 16
+
+
+// Bytes of each block filled with the header and records.
+#define RECORDER_BUFFER_SIZE 256
+
+
+// Location of the session number in the EEPROM (after magcal).
+#define RECORDER_EEPROM_ADDRESS 0x0040
+
+
+// Block header.
+#define RECORDER_MAGIC0 'R'
+#define RECORDER_MAGIC1 'L'
+#define RECORDER_HEADER_LENGTH 8
+
+
+// Record types.
+#define RECORDER_END 0
+#define RECORDER_ACC 1
+#define RECORDER_MAG 2
+#define RECORDER_ATT 3
+
+
+// Statistics, can be read with the debugger.
+extern uint16_t recorderDrops;      // records dropped
+extern uint16_t recorderErrors;     // blocks rejected by the card
+extern uint32_t recorderBlocks;     // blocks written
+
+
+// Description:
+//      Initialize the recorder.  Must be called after imuInit.  The card
+//      is brought up and a new session started by recorderTask, if there
+//      is no card the recorder does nothing.
+//
+void recorderInit(void);
+
+
+// Description:
+//      Record a raw accelerometer sample.  Only call from the low
+//      priority interrupt.
+//
+// Input:
+//      int16_t x, y, z:
+//          Accelerometer sample.
+//
+void recorderAcc(int16_t x, int16_t y, int16_t z);
+
+
+// Description:
+//      Record a raw magnetometer sample.  Only call from the low
+//      priority interrupt.
+//
+// Input:
+//      int16_t x, y, z:
+//          Magnetometer sample.
+//
+void recorderMag(int16_t x, int16_t y, int16_t z);
+
+
+// Description:
+//      Record an attitude solution.
+//
+// Input:
+//      int16_t yaw, pitch, roll:
+//          Attitude in TRIG16 units.
+//
+//      bool valid:
+//          True if the attitude solution can be trusted.
+//
+void recorderAttitude(int16_t yaw, int16_t pitch, int16_t roll,
+                      bool valid);
+
+
+// Description:
+//      Background task, brings up the card and then writes full buffers
+//      to it.  Each call either takes a bring-up step (see sdInitStep),
+//      starts a block write (about 2 ms), checks if the card is done
+//      programming, or does nothing.
+//
+void recorderTask(void);
+
+
+#endif // RECORDER_H
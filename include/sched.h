@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////
+// File: sched.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      A tick based cooperative task scheduler.  Timer 2 generates a 1
+//      millisecond tick from the high priority interrupt.  Each task is
+//      released every period ticks and must finish within deadline
+//      ticks of its release.  Tasks run to completion, when several are
+//      ready the one added first runs first.  When no task is ready the
+//      background task, if any, is run.
+//
+//      Execution times are measured in ticks and kept per task along
+//      with the number of runs and the number of deadline overruns.
+//
+//      All hardware access is in schedInit and the tick interrupt.  To
+//      run the scheduler against a simulated tick call schedISR in
+//      place of the timer interrupt.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef SCHED_H
+#define SCHED_H
+
+
+#define SCHED_MAX_TASKS 4   // maximum number of periodic tasks
+#define SCHED_TICK_MS 1     // milliseconds per tick
+
+
+// Scheduler tick interrupt flag.
+#define SCHED_TICK_FLAG (PIR1bits.TMR2IF)
+
+
+// Periodic task and its statistics.
+struct schedTask {
+    void (*run)(void);  // task function
+    uint16_t period;    // ticks between releases
+    uint16_t deadline;  // ticks after release the task must finish by
+    uint16_t release;   // tick of next release
+    uint16_t last;      // execution time of last run in ticks
+    uint16_t max;       // longest execution time in ticks
+    uint16_t runs;      // number of times run
+    uint16_t overruns;  // number of missed deadlines
+};
+
+
+// Task table, in order of priority.
+extern struct schedTask schedTasks[SCHED_MAX_TASKS];
+extern uint8_t schedTaskCount;
+
+
+// Tick count, read it with schedTicks or SCHED_TICKS_ISRL.
+extern volatile uint16_t schedTickCount;
+
+
+// Description:
+//      Read the tick count from the low priority interrupt.  Unlike
+//      schedTicks this is inline, so it does not use the .tmpdata
+//      section the low priority interrupt does not save.  The tick
+//      interrupt is held off while the two bytes are read.
+//
+// Input:
+//      uint16_t t:
+//          Variable to store the ticks in.
+//
+#define SCHED_TICKS_ISRL(t) do { \
+        INTCONbits.GIEH = 0; \
+        (t) = schedTickCount; \
+        INTCONbits.GIEH = 1; \
+    } while (0)
+
+
+// Description:
+//      Initialize the scheduler and start the tick timer.  The tick
+//      will not run until high priority interrupts are enabled.
+//
+void schedInit(void);
+
+
+// Description:
+//      Add a periodic task.  Tasks added first have the highest
+//      priority.
+//
+// Input:
+//      void (*run)(void):
+//          Task function.
+//
+//      uint16_t period:
+//          Ticks between releases.
+//
+//      uint16_t deadline:
+//          Ticks after release the task must finish by, usually the
+//          period.
+//
+//      uint16_t offset:
+//          Ticks from now until the first release, used to keep tasks
+//          from being released on the same tick.
+//
+// Output (uint8_t):
+//      Index of the task in schedTasks or SCHED_MAX_TASKS if the table
+//      is full.
+//
+uint8_t schedAdd(void (*run)(void), uint16_t period, uint16_t deadline,
+                 uint16_t offset);
+
+
+// Description:
+//      Set the background task, run whenever no periodic task is ready.
+//      It should return quickly to keep the release jitter of the
+//      periodic tasks low.
+//
+// Input:
+//      void (*run)(void):
+//          Background task function or 0 for none.
+//
+void schedBackground(void (*run)(void));
+
+
+// Description:
+//      Run the scheduler, never returns.
+//
+void schedRun(void);
+
+
+// Description:
+//      Get the current tick count.  Wraps every 65536 ticks.
+//
+// Output (uint16_t):
+//      Ticks since schedInit.
+//
+uint16_t schedTicks(void);
+
+
+// Description:
+//      Clear the statistics of all tasks.
+//
+void schedClearStats(void);
+
+
+// Description:
+//      Scheduler tick interrupt service routine, counts one tick.
+//
+void schedISR(void);
+
+
+#endif // SCHED_H
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////
+// File: scroll.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Writes the EFIS to the OLED, scrolling wings level frames with
+//      the display start line instead of writing them whole.
+//
+//      In a wings level frame the horizon and the pitch lines only move
+//      up or down with pitch.  When both the last and the new frame are
+//      wings level the start line is moved by the pitch change, which
+//      moves the image already in display RAM, and only these are
+//      written (see oledWriteRows):
+//
+//          - the rows scrolled in at the top or bottom,
+//          - the overlays fixed to the screen (compass, plane symbol and
+//            bank indicator) at their old and new display RAM rows, or
+//            only the compass if the pitch has not changed and the
+//            heading has,
+//          - pitch lines drawn in one frame but not the other.
+//
+//      Anything else is written whole: roll (see efisDraw_), the invalid
+//      boxes, a change of efisLayers or a pitch change of more than
+//      SCROLL_MAX_ROWS.  The frame buffer is always the whole frame, so
+//      it can still be drawn on before it is written.
+//
+//      Display RAM is taken to hold the last frame scrollWrite wrote.
+//      Anything else that writes to the OLED (see anim.h) must call
+//      scrollInvalidate.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+
+
+#ifndef SCROLL_H
+#define SCROLL_H
+
+
+// Largest pitch change in pixels that is scrolled.
+#define SCROLL_MAX_ROWS 16
+
+
+// Frames written since the start, and the ones that were scrolled.
+extern uint16_t scrollFrames;
+extern uint16_t scrollScrolled;
+
+
+// Description:
+//      Write the frame drawn by efisDraw to the OLED, scrolled if it and
+//      the last frame are wings level.
+//
+void scrollWrite(void);
+
+
+// Description:
+//      Forget the last frame written, so the next scrollWrite writes the
+//      whole frame.
+//
+void scrollInvalidate(void);
+
+
+#endif // SCROLL_H
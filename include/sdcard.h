@@ -9,12 +9,28 @@
 //      This library is used to talk to the 2908-05WB-MG SD card
 //      connector.
 //
-//      This library currently contains only the minimum macros needed
-//      to unselect the chip.
+//      The card is used in SPI mode and only supports writing single
+//      512 byte blocks.  Both standard capacity (byte addressed) and
+//      high capacity (block addressed) cards are supported, blocks are
+//      always given by block number.  Bring-up is split into steps (see
+//      sdInitStep) so it does not hold up the boot.
+//
+//      The card shares SPI1 with the IMU.  Each transaction is run with
+//      low priority interrupts disabled so the IMU interrupt cannot use
+//      the bus while the card is selected.  High priority interrupts are
+//      left on.
+//
+//      Writes do not wait for the card to finish programming.  The card
+//      is deselected while it is busy so the IMU can use the bus, use
+//      sdBusy to check when the next block can be written.
 //
 ////////////////////////////////////////////////////////////////////////
 
 
+#include "stdint.h"
+#include "stdbool.h"
+
+
 #ifndef SDCARD_H
 #define SDCARD_H
 
@@ -25,4 +41,70 @@
 #define SDC_DESELECT() (LATHbits.LATH0 = 1)
 
 
+#define SDC_BLOCK_SIZE 512
+
+
+// Results of sdInitStep.
+#define SDC_INIT_PENDING 0
+#define SDC_INIT_READY 1
+#define SDC_INIT_FAILED 2
+
+
+// Description:
+//      Start bringing up the card, the work is done by sdInitStep.  The
+//      select pin must have been set up (see imuInit).
+//
+void sdInit(void);
+
+
+// Description:
+//      Take the next step of bringing up the card.  Each call runs at
+//      most one command, under half a millisecond with low priority
+//      interrupts off, so it can be called from a background task.
+//      While the card leaves the idle state, usually a few hundred
+//      milliseconds and at most a second, it is polled once a tick.
+//      Must be called after schedInit.
+//
+//      SPI1 is clocked at Fosc/64 for these commands and returned to the
+//      IMU settings afterwards.  Timer 2 ticks the scheduler so this is
+//      the slowest clock left, 625 kHz with the PLL where the SD
+//      specification asks for at most 400 kHz until the card is ready.
+//
+// Output (uint8_t):
+//      SDC_INIT_PENDING until the card is ready (SDC_INIT_READY) or
+//      was not found (SDC_INIT_FAILED).
+//
+uint8_t sdInitStep(void);
+
+
+// Description:
+//      Start writing a block.  The function returns once the card has
+//      accepted the data, about 2 ms with low priority interrupts off.
+//
+// Input:
+//      uint32_t block:
+//          Block number to write.
+//
+//      const uint8_t *data:
+//          Data to write.
+//
+//      uint16_t length:
+//          Bytes of data, at most SDC_BLOCK_SIZE.  The rest of the
+//          block is written with zeros.
+//
+// Output (bool):
+//      True if the card accepted the block.
+//
+bool sdWriteBlock(uint32_t block, const uint8_t *data, uint16_t length);
+
+
+// Description:
+//      Check if the card is still programming the last block.
+//
+// Output (bool):
+//      True if the card is busy.
+//
+bool sdBusy(void);
+
+
 #endif // SDCARD_H
@@ -146,4 +146,21 @@ void spi1Exchange(uint8_t len, uint8_t *outPtr, uint8_t *inPtr);
 void spi2Exchange(uint8_t len, uint8_t *outPtr, uint8_t *inPtr);
 
 
+// Description:
+//      Send a block over SPI2, throwing away the received bytes.  Each
+//      byte is loaded as soon as the last one is done, without the
+//      collision check and per byte call of spi2ExchangeByte.  The bus
+//      must be idle (no exchange in progress) when called.
+//
+// Input:
+//      const uint8_t *buf / const rom uint8_t *buf:
+//          Bytes to send, from RAM or program memory.
+//
+//      uint16_t len:
+//          Number of bytes to send.
+//
+void spi2Write(const uint8_t *buf, uint16_t len);
+void spi2WriteROM(const rom uint8_t *buf, uint16_t len);
+
+
 #endif // SPILIB_H
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////
+// File: spitrace.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      SPI bus trace.  Every transaction, from before the chip select is
+//      asserted to after it is released, is recorded into a RAM ring
+//      with its bus, device, kind, byte count, write collisions and
+//      start and end times.  Times are timer 1 counts (see profile.h,
+//      0.8 us at the default 1:8 prescale and 40 MHz).
+//
+//      The ring is drained by telemetrySpiTrace onto the TLM_SPI_TRACE
+//      channel and the spistat script turns the capture into bus
+//      utilization, gaps and per device bandwidth.  When the ring is
+//      full records are dropped and counted.
+//
+//      The macros, the ring and the functions compile to nothing unless
+//      SPI_TRACE is defined in config.h.  A bus must not be traced from both the main line and
+//      the IMU interrupt at the same time, SPI1 users other than the
+//      IMU already hold off the interrupt while selected.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "config.h"
+#include "stdint.h"
+
+
+#ifndef SPITRACE_H
+#define SPITRACE_H
+
+
+// Number of records in the ring, keep the ring within one bank.
+#define SPI_TRACE_LENGTH 24
+
+
+// Buses.
+#define SPI_TRACE_SPI1 0
+#define SPI_TRACE_SPI2 1
+#define SPI_TRACE_BUSES 2
+
+
+// Devices.
+#define SPI_TRACE_IMU 0
+#define SPI_TRACE_EEPROM 1
+#define SPI_TRACE_SDCARD 2
+#define SPI_TRACE_OLED 3
+
+
+// Kinds of transaction.
+#define SPI_TRACE_EXCHANGE 0    // mixed or unknown
+#define SPI_TRACE_READ 1        // register read
+#define SPI_TRACE_WRITE 2       // register write
+#define SPI_TRACE_COMMAND 3     // display command bytes
+#define SPI_TRACE_DATA 4        // display data bytes
+
+
+// A traced transaction, 9 bytes when sent.
+struct spiTraceRecord {
+    uint8_t device;     // device (bus in the upper nibble)
+    uint8_t kind;       // kind of transaction
+    uint8_t collisions; // write collisions
+    uint16_t length;    // bytes exchanged
+    uint16_t start;     // timer 1 before selecting
+    uint16_t end;       // timer 1 after deselecting
+};
+
+
+// Records dropped because the ring was full.
+extern uint16_t spiTraceDrops;
+
+
+// Per bus byte and collision counters of the open transaction, updated
+// by spilib.
+extern uint16_t spiTraceBytes[SPI_TRACE_BUSES];
+extern uint8_t spiTraceCollisions[SPI_TRACE_BUSES];
+
+
+// Description:
+//      Macros to mark the beginning and end of a transaction and count
+//      its bytes and collisions.
+//
+// Input:
+//      bus:
+//          SPI_TRACE_SPI1 or SPI_TRACE_SPI2.
+//
+//      count:
+//          Number of bytes.
+//
+//      device:
+//          Device identifier.
+//
+//      kind:
+//          Kind of transaction.
+//
+#ifdef SPI_TRACE
+#define SPI_TRACE_BEGIN(bus) spiTraceBegin(bus)
+#define SPI_TRACE_END(bus, device, kind) spiTraceEnd(bus, device, kind)
+#define SPI_TRACE_BYTE(bus) (++spiTraceBytes[bus])
+#define SPI_TRACE_BYTES(bus, count) (spiTraceBytes[bus] += (count))
+#define SPI_TRACE_COLLISION(bus) (++spiTraceCollisions[bus])
+#else
+#define SPI_TRACE_BEGIN(bus)
+#define SPI_TRACE_END(bus, device, kind)
+#define SPI_TRACE_BYTE(bus)
+#define SPI_TRACE_BYTES(bus, count)
+#define SPI_TRACE_COLLISION(bus)
+#endif
+
+
+// Description:
+//      Start timer 1 (with profileInit) and clear the ring.
+//
+void spiTraceInit(void);
+
+
+// Description:
+//      Begin a transaction, use SPI_TRACE_BEGIN instead.
+//
+// Input:
+//      uint8_t bus:
+//          Bus of the transaction.
+//
+void spiTraceBegin(uint8_t bus);
+
+
+// Description:
+//      End a transaction and add it to the ring, use SPI_TRACE_END
+//      instead.
+//
+// Input:
+//      uint8_t bus:
+//          Bus of the transaction.
+//
+//      uint8_t device:
+//          Device identifier.
+//
+//      uint8_t kind:
+//          Kind of transaction.
+//
+void spiTraceEnd(uint8_t bus, uint8_t device, uint8_t kind);
+
+
+// Description:
+//      Take the oldest records out of the ring.
+//
+// Input:
+//      struct spiTraceRecord *records:
+//          Location to copy the records to.
+//
+//      uint8_t max:
+//          Most records to take.
+//
+// Output (uint8_t):
+//      Number of records taken.
+//
+uint8_t spiTraceRead(struct spiTraceRecord *records, uint8_t max);
+
+
+#endif // SPITRACE_H
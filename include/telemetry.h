@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////
+// File: telemetry.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Framed binary telemetry sent over the UART (see uart.h).  Each
+//      frame is:
+//
+//          sync0 sync1 channel sequence length payload crcLow crcHigh
+//
+//      The sequence number counts every frame, including dropped ones,
+//      so the receiver can detect lost frames.  The CRC is CRC-16-CCITT
+//      (polynomial 0x1021, initial value 0xFFFF) over the channel,
+//      sequence, length and payload bytes.  All payload values are
+//      little endian.
+//
+//      Frames are dropped, and counted, when the transmit buffer does
+//      not have room for them.  Sending never waits for the UART.
+//
+//      The host side decoder is the tlmdump script.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+
+// Frame format.
+#define TLM_SYNC0 0xA5
+#define TLM_SYNC1 0x5A
+#define TLM_HEADER_LENGTH 5
+#define TLM_CRC_LENGTH 2
+#define TLM_MAX_PAYLOAD 48
+
+
+// Channels and their payloads.
+#define TLM_RAW_IMU 0   // int16_t accX, accY, accZ, magX, magY, magZ
+#define TLM_VECTORS 1   // int16_t accX, accY, accZ, magX, magY, magZ
+#define TLM_ATTITUDE 2  // int16_t yaw, pitch, roll; uint8_t valid
+#define TLM_PROFILE 3   // uint16_t meanUs, maxUs, count per section
+#define TLM_STATUS 4    // see telemetryStatus
+#define TLM_SPI_TRACE 5 // see telemetrySpiTrace
+#define TLM_CHANNELS 6
+
+
+// Description:
+//      Macro to convert a channel to its bit in the channel mask.
+//
+// Input:
+//      channel:
+//          Telemetry channel.
+//
+// Output (uint8_t):
+//      Channel mask bit.
+//
+#define TLM_CHANNEL(channel) ((uint8_t)(1 << (channel)))
+
+
+// Number of frames dropped because the transmit buffer was full.
+extern uint16_t telemetryDrops;
+
+
+// Description:
+//      Initialize the UART and select the channels to send.
+//
+// Input:
+//      uint8_t channels:
+//          Mask of the channels to send, built with TLM_CHANNEL.
+//
+void telemetryInit(uint8_t channels);
+
+
+// Description:
+//      Check if a channel is being sent.
+//
+// Input:
+//      uint8_t channel:
+//          Telemetry channel.
+//
+// Output (bool):
+//      True if the channel is selected.
+//
+bool telemetryEnabled(uint8_t channel);
+
+
+// Description:
+//      Frame and queue a payload.  Nothing is sent if the channel is not
+//      selected.
+//
+// Input:
+//      uint8_t channel:
+//          Telemetry channel.
+//
+//      const uint8_t *payload:
+//          Payload bytes.
+//
+//      uint8_t length:
+//          Length of payload, at most TLM_MAX_PAYLOAD.
+//
+// Output (bool):
+//      True if the frame was queued.
+//
+bool telemetrySend(uint8_t channel, const uint8_t *payload, uint8_t length);
+
+
+// Description:
+//      Send the latest accelerometer and magnetometer sample from the
+//      IMU buffers (TLM_RAW_IMU).
+//
+void telemetryRawImu(void);
+
+
+// Description:
+//      Send the boxcar filtered and calibrated accelerometer and
+//      magnetometer vectors (TLM_VECTORS).
+//
+void telemetryVectors(void);
+
+
+// Description:
+//      Send the attitude solution (TLM_ATTITUDE).
+//
+// Input:
+//      int16_t yaw, pitch, roll:
+//          Attitude in TRIG16 units.
+//
+//      bool valid:
+//          True if the attitude solution can be trusted.
+//
+void telemetryAttitude(int16_t yaw, int16_t pitch, int16_t roll,
+                       bool valid);
+
+
+// Description:
+//      Send the profiler statistics (TLM_PROFILE).  Only compiled with
+//      PROFILE defined in config.h (see profile.h).
+//
+void telemetryProfile(void);
+
+
+// Description:
+//      Send the system status (TLM_STATUS).  The payload is the four
+//      arguments and the number of dropped frames followed by the
+//      maximum execution time and overrun count (uint16_t each) of every
+//      scheduler task.
+//
+// Input:
+//      uint16_t bootTime:
+//          Milliseconds to the first valid frame.
+//
+//      int16_t headroom, headroomMin:
+//          Last and least render headroom in milliseconds.
+//
+//      uint8_t layers:
+//          EFIS layers being drawn.
+//
+void telemetryStatus(uint16_t bootTime, int16_t headroom,
+                     int16_t headroomMin, uint8_t layers);
+
+
+// Description:
+//      Send the SPI trace (TLM_SPI_TRACE), draining up to
+//      TLM_SPI_TRACE_FRAMES frames of records from the ring.  The
+//      payload is the number of dropped records (uint16_t) followed by
+//      up to TLM_SPI_TRACE_RECORDS records, each:
+//
+//          uint8_t device      bus in the upper nibble
+//          uint8_t kind
+//          uint8_t collisions
+//          uint16_t length
+//          uint16_t start, end timer 1 counts
+//
+//      Only compiled with SPI_TRACE defined in config.h (see
+//      spitrace.h).
+//
+#define TLM_SPI_TRACE_RECORDS 5
+#define TLM_SPI_TRACE_FRAMES 2
+void telemetrySpiTrace(void);
+
+
+#endif // TELEMETRY_H
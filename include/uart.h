@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////
+// File: uart.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+// Description:
+//      Transmit only driver for EUSART1 (TX1 on RC6).  Bytes are queued
+//      in a ring buffer and sent from the low priority interrupt so
+//      writing never waits for the line.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+
+#ifndef UART_H
+#define UART_H
+
+
+#define UART_BAUD 115200L
+
+
+// Length of the transmit ring buffer, must be a power of 2 no larger
+// than 256.  One byte is always left empty.
+#define UART_TX_BUFFER_LENGTH 128
+
+
+// Transmit interrupt flag and enable.
+#define UART_TX_INT_FLAG (PIR1bits.TX1IF)
+#define UART_TX_INT_ENABLE (PIE1bits.TX1IE)
+
+
+// Description:
+//      Initialize EUSART1 for asynchronous 8N1 transmission at
+//      UART_BAUD with a low priority transmit interrupt.
+//
+void uartInit(void);
+
+
+// Description:
+//      Get the free space in the transmit buffer.
+//
+// Output (uint8_t):
+//      Number of bytes that can be written.
+//
+uint8_t uartFree(void);
+
+
+// Description:
+//      Queue bytes for transmission.  Either all of the bytes are queued
+//      or none of them are, so partial messages are never sent.
+//
+// Input:
+//      const uint8_t *data:
+//          Bytes to send.
+//
+//      uint8_t length:
+//          Number of bytes to send.
+//
+// Output (bool):
+//      False if there was not enough room in the transmit buffer.
+//
+bool uartWrite(const uint8_t *data, uint8_t length);
+
+
+// Description:
+//      Low priority transmit interrupt service routine.  Moves the next
+//      byte from the ring buffer to the EUSART and turns the interrupt
+//      off once the buffer is empty.
+//
+void uartISR(void);
+
+
+#endif // UART_H
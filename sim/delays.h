@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////
+// File: delays.h (simulator)
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Stand-in for the C18 delay library used by the host simulator.
+//      Each delay advances the simulated clock, running peripherals and
+//      interrupts as it goes.  As with C18 a count of zero is 256.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DELAYS_H
+#define DELAYS_H
+
+
+#include <stdint.h>
+
+
+// Description:
+//      Spend a number of instruction cycles.
+//
+// Input:
+//      uint32_t cycles:
+//          Instruction cycles to spend.
+//
+void simDelay(uint32_t cycles);
+
+
+#define SIM_DELAY_COUNT(n) \
+    ((uint8_t)(n) != 0 ? (uint32_t)(uint8_t)(n) : 256UL)
+
+#define Delay1TCY() simDelay(1)
+#define Delay10TCYx(n) simDelay(10UL*SIM_DELAY_COUNT(n))
+#define Delay100TCYx(n) simDelay(100UL*SIM_DELAY_COUNT(n))
+#define Delay1KTCYx(n) simDelay(1000UL*SIM_DELAY_COUNT(n))
+#define Delay10KTCYx(n) simDelay(10000UL*SIM_DELAY_COUNT(n))
+
+
+#endif // DELAYS_H
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////
+// File: eeprom25.c
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Behavioral model of the 25xx128 SPI EEPROM for the host
+//      simulator.  Supports READ, WRITE, WREN, WRDI and RDSR with 64
+//      byte pages (writes wrap within the page) and a 5 ms write cycle
+//      during which WIP is set.  A blank part reads 0xFF.  The contents
+//      can be loaded from and saved to a file, so the magnetometer
+//      calibration and recorder session number persist between runs.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+#include "sim.h"
+
+
+#define SIZE 16384
+#define PAGE_SIZE 64
+#define WRITE_CYCLES (SIM_FCY/200)  // 5 ms
+
+#define READ    0x03
+#define WRITE   0x02
+#define WRDI    0x04
+#define WREN    0x06
+#define RDSR    0x05
+#define WIP     0x01
+#define WEL     0x02
+
+
+static uint8_t memory[SIZE];
+static uint8_t page[PAGE_SIZE];
+static uint8_t pageWritten[PAGE_SIZE];
+static const char *file = 0;
+
+
+// Transfer state.
+static uint8_t selected = 0, command, count, writeEnable = 0;
+static uint16_t address;
+static uint64_t busyUntil = 0;
+
+
+void eeprom25Init(const char *path){
+
+    FILE *f;
+
+    memset(memory, 0xFF, SIZE);
+    file = path;
+    if (file && (f = fopen(file, "rb"))){
+        if (fread(memory, 1, SIZE, f) != SIZE){
+            fprintf(stderr, "%s: short EEPROM image\n", file);
+        }
+        fclose(f);
+    }
+}
+
+
+void eeprom25Save(void){
+
+    FILE *f;
+
+    if (!file){
+        return;
+    }
+    if (!(f = fopen(file, "wb")) || fwrite(memory, 1, SIZE, f) != SIZE){
+        perror(file);
+    }
+    if (f){
+        fclose(f);
+    }
+}
+
+
+void eeprom25Select(void){
+    selected = 1;
+    count = 0;
+    memset(pageWritten, 0, PAGE_SIZE);
+}
+
+
+void eeprom25Deselect(void){
+
+    uint8_t i;
+    uint16_t base;
+
+    selected = 0;
+
+    // Start the write cycle of a WRITE with data.
+    if (count > 3 && command == WRITE && writeEnable){
+        base = address & ~(PAGE_SIZE - 1) & (SIZE - 1);
+        for (i = 0; i < PAGE_SIZE; ++i){
+            if (pageWritten[i]){
+                memory[base + i] = page[i];
+            }
+        }
+        busyUntil = simCycles + WRITE_CYCLES;
+        writeEnable = 0;
+    }
+    if (count == 1 && command == WREN && simCycles >= busyUntil){
+        writeEnable = 1;
+    }
+    if (count == 1 && command == WRDI){
+        writeEnable = 0;
+    }
+}
+
+
+uint8_t eeprom25Exchange(uint8_t out){
+
+    uint8_t in = 0xFF;
+
+    if (!selected){
+        return 0xFF;
+    }
+    if (count == 0){
+        command = out;
+    } else if (command == RDSR){
+        in = (simCycles < busyUntil ? WIP : 0) | (writeEnable ? WEL : 0);
+    } else if (simCycles < busyUntil){
+        // Ignored during a write cycle.
+    } else if (command == READ || command == WRITE){
+        if (count == 1){
+            address = (uint16_t)out << 8;
+        } else if (count == 2){
+            address |= out;
+        } else if (command == READ){
+            in = memory[address & (SIZE - 1)];
+            ++address;
+        } else {
+            page[address % PAGE_SIZE] = out;
+            pageWritten[address % PAGE_SIZE] = 1;
+            address = (address & ~(PAGE_SIZE - 1)) |
+                      ((address + 1) & (PAGE_SIZE - 1));
+        }
+    }
+    if (count < 255){
+        ++count;
+    }
+    return in;
+}
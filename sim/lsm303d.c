@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////
+// File: lsm303d.c
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Behavioral model of the LSM303D accelerometer/magnetometer for
+//      the host simulator.
+//
+//      Registers are read and written over SPI with the read (bit 7)
+//      and auto increment (bit 6) bits of the command byte.  Samples
+//      are produced at the output data rates set in CTRL1 and CTRL5
+//      from the attitude given by a motion script, with gaussian noise.
+//      New data sets ZYXADA/ZYXMDA in STATUS_A/STATUS_M and, when
+//      routed there by CTRL4, drives the INT2 pin high until the Z high
+//      byte of the sample is read.  A sample arriving before the last
+//      one was read counts as an overrun.
+//
+//      The motion script has one line per key frame with the time in
+//      seconds and roll, pitch and yaw in degrees, the attitude is
+//      interpolated between them.  Without a script the plane flies the
+//      same pattern as the synthetic mode of the replay tool.
+//
+//      Units match replay: 1 g is 16383 counts and the magnetic field
+//      is 4000 counts with a 60 degree inclination.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "config.h"
+#include "sim.h"
+
+
+#define CTRL1       0x20
+#define CTRL4       0x23
+#define CTRL5       0x24
+#define CTRL7       0x26
+#define STATUS_M    0x07
+#define OUT_X_L_M   0x08
+#define OUT_Z_H_M   0x0D
+#define WHO_AM_I    0x0F
+#define STATUS_A    0x27
+#define OUT_X_L_A   0x28
+#define OUT_Z_H_A   0x2D
+
+#define ZYXOR       0x80    // STATUS_x overrun
+#define ZYXDA       0x08    // STATUS_x new data
+#define INT2_DRDY_A 0x08
+#define INT2_DRDY_M 0x04
+
+#define ONE 16383.0
+#define FIELD 4000.0
+#define INCLINATION (60.0*M_PI/180.0)
+
+
+struct lsm303dStats lsm303dStats;
+
+
+// Motion script key frames.
+struct keyFrame {
+    double t, roll, pitch, yaw;
+};
+static struct keyFrame *keyFrames = 0;
+static int keyFrameCount = 0;
+
+
+// Register file and SPI state.
+static uint8_t regs[0x40];
+static uint8_t accOut[6], magOut[6];
+static uint8_t selected = 0, address, command, reading, increment;
+
+
+// Sample timing.
+static uint64_t accNext = 0, magNext = 0;
+static uint8_t accRate = 0, magRate = 0;
+
+
+// Noise.
+static double noise;
+static uint32_t rngState;
+
+
+// Description:
+//      Uniform random number in (0, 1), xorshift.
+//
+static double uniform(void){
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState + 0.5)/4294967296.0;
+}
+
+
+// Description:
+//      Gaussian random number, Box-Muller.
+//
+static double gauss(double sigma){
+    return sigma*sqrt(-2.0*log(uniform()))*cos(2.0*M_PI*uniform());
+}
+
+
+// Description:
+//      Load a motion script.
+//
+static void loadMotion(const char *path){
+
+    FILE *f;
+    char line[256];
+    struct keyFrame k;
+
+    if (!(f = fopen(path, "r"))){
+        perror(path);
+        exit(1);
+    }
+    while (fgets(line, sizeof(line), f)){
+        if (sscanf(line, "%lf %lf %lf %lf", &k.t, &k.roll, &k.pitch,
+                   &k.yaw) != 4){
+            continue;   // comment or blank line
+        }
+        keyFrames = realloc(keyFrames, (keyFrameCount + 1)*sizeof(k));
+        keyFrames[keyFrameCount++] = k;
+    }
+    fclose(f);
+    if (keyFrameCount == 0){
+        fprintf(stderr, "%s: no key frames\n", path);
+        exit(1);
+    }
+}
+
+
+// Description:
+//      Attitude at a time, in radians.
+//
+static void attitude(double t, double *roll, double *pitch, double *yaw){
+
+    int i;
+    double a;
+    struct keyFrame *k0, *k1;
+
+    if (keyFrameCount == 0){
+        // Same as replay --synthetic.
+        *roll = 60.0*sin(2.0*M_PI*t/8.0);
+        *pitch = 20.0*sin(2.0*M_PI*t/5.0);
+        *yaw = fmod(360.0*t/30.0, 360.0);
+    } else {
+        for (i = 1; i < keyFrameCount && keyFrames[i].t <= t; ++i);
+        k1 = &keyFrames[i < keyFrameCount ? i : keyFrameCount - 1];
+        k0 = &keyFrames[i - 1];
+        a = k1->t > k0->t ? (t - k0->t)/(k1->t - k0->t) : 0.0;
+        a = a < 0.0 ? 0.0 : a > 1.0 ? 1.0 : a;
+        *roll = k0->roll + a*(k1->roll - k0->roll);
+        *pitch = k0->pitch + a*(k1->pitch - k0->pitch);
+        *yaw = k0->yaw + a*(k1->yaw - k0->yaw);
+    }
+    *roll *= M_PI/180.0;
+    *pitch *= M_PI/180.0;
+    *yaw *= M_PI/180.0;
+}
+
+
+// Description:
+//      Store a sample as little endian output registers.
+//
+static void store(uint8_t *out, const double *v, double sigma){
+
+    int i;
+    double x;
+    int16_t n;
+
+    for (i = 0; i < 3; ++i){
+        x = v[i] + gauss(sigma);
+        x = x < -32768.0 ? -32768.0 : x > 32767.0 ? 32767.0 : x;
+        n = (int16_t)lround(x);
+        out[2*i] = (uint8_t)n;
+        out[2*i+1] = (uint8_t)((uint16_t)n >> 8);
+    }
+}
+
+
+// Description:
+//      Produce accelerometer and/or magnetometer samples for now.
+//
+static void sample(int acc, int mag){
+
+    double roll, pitch, yaw, sr, cr, sp, cp, sy, cy;
+    double north[3], h[3], g[3], m[3], v[3];
+
+    attitude(simSeconds(simCycles), &roll, &pitch, &yaw);
+    sr = sin(roll); cr = cos(roll);
+    sp = sin(pitch); cp = cos(pitch);
+    sy = sin(yaw); cy = cos(yaw);
+
+    // Gravity and magnetic field in the plane frame (x forward,
+    // y starboard, z down), earth to body rotation yaw-pitch-roll.
+    g[0] = -sp; g[1] = cp*sr; g[2] = cp*cr;
+    north[0] = FIELD*cos(INCLINATION);
+    north[2] = FIELD*sin(INCLINATION);
+    h[0] = cy*north[0]; h[1] = -sy*north[0]; h[2] = north[2];
+    m[0] = cp*h[0] - sp*h[2];
+    m[1] = sr*sp*h[0] + cr*h[1] + sr*cp*h[2];
+    m[2] = cr*sp*h[0] - sr*h[1] + cr*cp*h[2];
+
+    // Sensor frame.
+    if (acc){
+        v[0] = -g[0]*ONE; v[1] = g[1]*ONE; v[2] = g[2]*ONE;
+        store(accOut, v, noise);
+        if (regs[STATUS_A] & ZYXDA){
+            regs[STATUS_A] |= ZYXOR;
+            ++lsm303dStats.accOverruns;
+        }
+        regs[STATUS_A] |= ZYXDA;
+        ++lsm303dStats.accSamples;
+    }
+    if (mag){
+        v[0] = m[0]; v[1] = -m[1]; v[2] = -m[2];
+        store(magOut, v, noise/4);
+        if (regs[STATUS_M] & ZYXDA){
+            regs[STATUS_M] |= ZYXOR;
+            ++lsm303dStats.magOverruns;
+        }
+        regs[STATUS_M] |= ZYXDA;
+        ++lsm303dStats.magSamples;
+    }
+}
+
+
+// Description:
+//      Sample period in cycles for an ODR code, 3.125 Hz doubling per
+//      step, zero when off.
+//
+static uint64_t period(uint8_t rate){
+    return rate ? (uint64_t)(SIM_FCY/3.125) >> (rate - 1) : 0;
+}
+
+
+void lsm303dInit(const char *motion, double sigma, uint32_t seed){
+
+    if (motion){
+        loadMotion(motion);
+    }
+    noise = sigma;
+    rngState = seed ? seed : 1;
+
+    // Power on values.
+    regs[WHO_AM_I] = 0x49;
+    regs[0x12] = 0xE8;  // INT_CTRL_M
+    regs[CTRL1] = 0x07;
+    regs[CTRL5] = 0x18;
+    regs[0x25] = 0x20;  // CTRL6
+    regs[CTRL7] = 0x01;
+}
+
+
+void lsm303dSelect(void){
+    selected = 1;
+    command = 1;
+}
+
+
+void lsm303dDeselect(void){
+    selected = 0;
+}
+
+
+uint8_t lsm303dExchange(uint8_t out){
+
+    uint8_t in = 0xFF;
+
+    if (!selected){
+        return 0xFF;
+    }
+    if (command){
+        command = 0;
+        reading = out & 0x80;
+        increment = out & 0x40;
+        address = out & 0x3F;
+        return 0xFF;
+    }
+
+    if (reading){
+        if (address >= OUT_X_L_A && address <= OUT_Z_H_A){
+            in = accOut[address - OUT_X_L_A];
+            if (address == OUT_Z_H_A && regs[STATUS_A] & ZYXDA){
+                regs[STATUS_A] &= ~(ZYXDA | ZYXOR);
+                ++lsm303dStats.accReads;
+            }
+        } else if (address >= OUT_X_L_M && address <= OUT_Z_H_M){
+            in = magOut[address - OUT_X_L_M];
+            if (address == OUT_Z_H_M && regs[STATUS_M] & ZYXDA){
+                regs[STATUS_M] &= ~(ZYXDA | ZYXOR);
+                ++lsm303dStats.magReads;
+            }
+        } else {
+            in = regs[address];
+        }
+    } else if (address >= 0x12 && address != STATUS_A &&
+               (address < OUT_X_L_A || address > OUT_Z_H_A)){
+        regs[address] = out;
+    }
+
+    if (increment){
+        address = (address + 1) & 0x3F;
+    }
+    return in;
+}
+
+
+void lsm303dStep(void){
+
+    uint8_t rate;
+    int acc = 0, mag = 0;
+
+    // Restart the sample clocks when the data rates change.  The
+    // magnetometer runs off the same clock a little later.
+    rate = regs[CTRL1] >> 4;
+    if (rate > 10){
+        rate = 10;
+    }
+    if (rate != accRate){
+        accRate = rate;
+        accNext = simCycles + period(rate);
+    }
+    rate = (regs[CTRL7] & 0x03) ? 0 : ((regs[CTRL5] >> 2) & 0x07) + 1;
+    if (rate > 6){
+        rate = 6;
+    }
+    if (rate != magRate){
+        magRate = rate;
+        magNext = simCycles + period(rate) + period(rate)/3;
+    }
+
+    if (accRate && simCycles >= accNext){
+        accNext += period(accRate);
+        acc = 1;
+    }
+    if (magRate && simCycles >= magNext){
+        magNext += period(magRate);
+        mag = 1;
+    }
+    if (acc || mag){
+        sample(acc, mag);
+    }
+}
+
+
+int lsm303dInt2(void){
+    return (regs[CTRL4] & INT2_DRDY_A && regs[STATUS_A] & ZYXDA) ||
+           (regs[CTRL4] & INT2_DRDY_M && regs[STATUS_M] & ZYXDA);
+}
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////
+// File: p18cxxx.h (simulator)
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Stand-in for the C18 register header used by the host simulator
+//      (see picsim).  Only the registers the firmware touches are
+//      modeled, each is a plain byte with a bit field view.
+//
+//      Registers with side effects (SSPxBUF, SSPxSTAT, SSPxCON1, TMR1L,
+//      TXREG1 and the LAT registers with chip selects on them) are
+//      functions returning a pointer to the register, so the simulator
+//      sees every access.  A write to one of them lands after the
+//      function returns and is picked up on the next access.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef P18CXXX_H
+#define P18CXXX_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Use the host fixed width types instead of include/stdint.h.
+#define STDINT_H
+typedef int32_t int24_t;
+typedef uint32_t uint24_t;
+
+
+// Time profiler sections with the host clock (see profile.h).
+#define PROFILE_HOST_CLOCK
+
+
+// C18 keywords and inline assembly.
+#define rom
+#define far
+#define near
+#define _asm
+#define _endasm
+#define GOTO
+#define Nop()
+
+
+// C18 library functions for program memory, which is data on the host.
+char *strncpypgm2ram(char *dest, const char *src, size_t n);
+
+
+// Bit field views, one byte each like the registers they overlay.
+typedef union {
+    struct {
+        uint8_t RBIF:1, INT0IF:1, TMR0IF:1, RBIE:1;
+        uint8_t INT0IE:1, TMR0IE:1, PEIE:1, GIE:1;
+    };
+    struct {
+        uint8_t :6, GIEL:1, GIEH:1;
+    };
+} INTCONbits_t;
+
+typedef struct {
+    uint8_t RBIP:1, INT3IP:1, TMR0IP:1, INTEDG3:1;
+    uint8_t INTEDG2:1, INTEDG1:1, INTEDG0:1, RBPU:1;
+} INTCON2bits_t;
+
+typedef struct {
+    uint8_t INT1IF:1, INT2IF:1, INT3IF:1, INT1IE:1;
+    uint8_t INT2IE:1, INT3IE:1, INT1IP:1, INT2IP:1;
+} INTCON3bits_t;
+
+typedef struct {
+    uint8_t BOR:1, POR:1, PD:1, TO:1, RI:1, CM:1, SBOREN:1, IPEN:1;
+} RCONbits_t;
+
+typedef struct {
+    uint8_t TMR1IF:1, TMR2IF:1, TMR1GIF:1, SSP1IF:1;
+    uint8_t TX1IF:1, RC1IF:1, ADIF:1, :1;
+} PIR1bits_t;
+
+typedef struct {
+    uint8_t TMR1IE:1, TMR2IE:1, TMR1GIE:1, SSP1IE:1;
+    uint8_t TX1IE:1, RC1IE:1, ADIE:1, :1;
+} PIE1bits_t;
+
+typedef struct {
+    uint8_t TMR1IP:1, TMR2IP:1, TMR1GIP:1, SSP1IP:1;
+    uint8_t TX1IP:1, RC1IP:1, ADIP:1, :1;
+} IPR1bits_t;
+
+typedef struct {
+    uint8_t CCP2IF:1, TMR3IF:1, HLVDIF:1, BCL1IF:1;
+    uint8_t :2, SSP2IF:1, OSCFIF:1;
+} PIR2bits_t;
+
+typedef struct {
+    uint8_t CCP2IE:1, TMR3IE:1, HLVDIE:1, BCL1IE:1;
+    uint8_t :2, SSP2IE:1, OSCFIE:1;
+} PIE2bits_t;
+
+typedef struct {
+    uint8_t CCP2IP:1, TMR3IP:1, HLVDIP:1, BCL1IP:1;
+    uint8_t :2, SSP2IP:1, OSCFIP:1;
+} IPR2bits_t;
+
+typedef struct {
+    uint8_t BF:1, UA:1, R_W:1, S:1, P:1, D_A:1, CKE:1, SMP:1;
+} SSPSTATbits_t;
+
+typedef struct {
+    uint8_t SSPM:4, CKP:1, SSPEN:1, SSPOV:1, WCOL:1;
+} SSPCON1bits_t;
+
+typedef struct {
+    uint8_t TMR1ON:1, RD16:1, T1SYNC:1, SOSCEN:1;
+    uint8_t T1CKPS:2, TMR1CS:2;
+} T1CONbits_t;
+
+typedef struct {
+    uint8_t T2CKPS:2, TMR2ON:1, T2OUTPS:4, :1;
+} T2CONbits_t;
+
+typedef struct {
+    uint8_t TX9D:1, TRMT:1, BRGH:1, SENDB:1;
+    uint8_t SYNC:1, TXEN:1, TX9:1, CSRC:1;
+} TXSTAbits_t;
+
+typedef struct {
+    uint8_t RX9D:1, OERR:1, FERR:1, ADDEN:1;
+    uint8_t CREN:1, SREN:1, RX9:1, SPEN:1;
+} RCSTAbits_t;
+
+typedef struct {
+    uint8_t ABDEN:1, WUE:1, :1, BRG16:1;
+    uint8_t TXCKP:1, RXDTP:1, RCIDL:1, ABDOVF:1;
+} BAUDCONbits_t;
+
+#define SIM_PORT_BITS(port) \
+    typedef struct { \
+        uint8_t LAT##port##0:1, LAT##port##1:1, LAT##port##2:1; \
+        uint8_t LAT##port##3:1, LAT##port##4:1, LAT##port##5:1; \
+        uint8_t LAT##port##6:1, LAT##port##7:1; \
+    } LAT##port##bits_t; \
+    typedef struct { \
+        uint8_t TRIS##port##0:1, TRIS##port##1:1, TRIS##port##2:1; \
+        uint8_t TRIS##port##3:1, TRIS##port##4:1, TRIS##port##5:1; \
+        uint8_t TRIS##port##6:1, TRIS##port##7:1; \
+    } TRIS##port##bits_t
+
+typedef struct {
+    uint8_t RB0:1, RB1:1, RB2:1, RB3:1, RB4:1, RB5:1, RB6:1, RB7:1;
+} PORTBbits_t;
+
+SIM_PORT_BITS(B);
+SIM_PORT_BITS(C);
+SIM_PORT_BITS(D);
+SIM_PORT_BITS(F);
+SIM_PORT_BITS(H);
+SIM_PORT_BITS(J);
+
+
+// Plain registers.
+extern volatile uint8_t INTCON, INTCON2, INTCON3, RCON;
+extern volatile uint8_t PIR1, PIE1, IPR1, PIR2, PIE2, IPR2;
+extern volatile uint8_t T1CON, T1GCON, TMR1H, T2CON, TMR2, PR2;
+extern volatile uint8_t TXSTA1, RCSTA1, BAUDCON1, SPBRG1, SPBRGH1;
+extern volatile uint8_t LATB, LATC, LATD, LATJ;
+extern volatile uint8_t TRISB, TRISC, TRISD, TRISF, TRISH, TRISJ;
+extern volatile uint8_t PORTB, PORTC;
+
+#define INTCONbits (*(volatile INTCONbits_t *)&INTCON)
+#define INTCON2bits (*(volatile INTCON2bits_t *)&INTCON2)
+#define INTCON3bits (*(volatile INTCON3bits_t *)&INTCON3)
+#define RCONbits (*(volatile RCONbits_t *)&RCON)
+#define PIR1bits (*(volatile PIR1bits_t *)&PIR1)
+#define PIE1bits (*(volatile PIE1bits_t *)&PIE1)
+#define IPR1bits (*(volatile IPR1bits_t *)&IPR1)
+#define PIR2bits (*(volatile PIR2bits_t *)&PIR2)
+#define PIE2bits (*(volatile PIE2bits_t *)&PIE2)
+#define IPR2bits (*(volatile IPR2bits_t *)&IPR2)
+#define T1CONbits (*(volatile T1CONbits_t *)&T1CON)
+#define T2CONbits (*(volatile T2CONbits_t *)&T2CON)
+#define TXSTA1bits (*(volatile TXSTAbits_t *)&TXSTA1)
+#define RCSTA1bits (*(volatile RCSTAbits_t *)&RCSTA1)
+#define BAUDCON1bits (*(volatile BAUDCONbits_t *)&BAUDCON1)
+#define PORTBbits (*(volatile PORTBbits_t *)&PORTB)
+#define LATBbits (*(volatile LATBbits_t *)&LATB)
+#define LATCbits (*(volatile LATCbits_t *)&LATC)
+#define LATDbits (*(volatile LATDbits_t *)&LATD)
+#define LATJbits (*(volatile LATJbits_t *)&LATJ)
+#define TRISBbits (*(volatile TRISBbits_t *)&TRISB)
+#define TRISCbits (*(volatile TRISCbits_t *)&TRISC)
+#define TRISDbits (*(volatile TRISDbits_t *)&TRISD)
+#define TRISFbits (*(volatile TRISFbits_t *)&TRISF)
+#define TRISHbits (*(volatile TRISHbits_t *)&TRISH)
+#define TRISJbits (*(volatile TRISJbits_t *)&TRISJ)
+
+
+// Registers with side effects.
+volatile uint8_t *simSspBuf(uint8_t port);
+volatile uint8_t *simSspStat(uint8_t port);
+volatile uint8_t *simSspCon1(uint8_t port);
+volatile uint8_t *simTmr1L(void);
+volatile uint8_t *simTxreg1(void);
+volatile uint8_t *simLatF(void);
+volatile uint8_t *simLatH(void);
+
+#define SSP1BUF (*simSspBuf(0))
+#define SSP1STAT (*simSspStat(0))
+#define SSP1CON1 (*simSspCon1(0))
+#define SSP1STATbits (*(volatile SSPSTATbits_t *)simSspStat(0))
+#define SSP1CON1bits (*(volatile SSPCON1bits_t *)simSspCon1(0))
+#define SSP2BUF (*simSspBuf(1))
+#define SSP2STAT (*simSspStat(1))
+#define SSP2CON1 (*simSspCon1(1))
+#define SSP2STATbits (*(volatile SSPSTATbits_t *)simSspStat(1))
+#define SSP2CON1bits (*(volatile SSPCON1bits_t *)simSspCon1(1))
+#define TMR1L (*simTmr1L())
+#define TXREG1 (*simTxreg1())
+#define LATF (*simLatF())
+#define LATH (*simLatH())
+#define LATFbits (*(volatile LATFbits_t *)simLatF())
+#define LATHbits (*(volatile LATHbits_t *)simLatH())
+
+
+#endif // P18CXXX_H
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////
+// File: sdspi.c
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Behavioral model of a high capacity (block addressed, version 2)
+//      SD card in SPI mode for the host simulator, backed by an image
+//      file.  Supports CMD0, CMD8, CMD16, CMD24, CMD55, ACMD41 and
+//      CMD58.  The CRC of CMD0 and CMD8 is checked, other commands are
+//      rejected as illegal.  The card stays idle for INIT_CYCLES after
+//      the first ACMD41 and holds data out low for PROGRAM_CYCLES after
+//      each block is written.  Blocks are written to the image as they
+//      are accepted, so the recorder output can be read back with the
+//      replay script.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+#include "sim.h"
+
+
+#define BLOCK_SIZE 512
+#define INIT_CYCLES (SIM_FCY/4)         // 250 ms
+#define PROGRAM_CYCLES (SIM_FCY/1000)   // 1 ms
+
+#define CMD0    0
+#define CMD8    8
+#define CMD16   16
+#define CMD24   24
+#define CMD55   55
+#define CMD58   58
+#define ACMD41  41
+
+#define R1_IDLE         0x01
+#define R1_ILLEGAL      0x04
+#define R1_CRC          0x08
+#define TOKEN_START     0xFE
+#define DATA_ACCEPTED   0xE5
+
+
+// Transfer states.
+#define COMMAND 0       // waiting for or reading a command
+#define TOKEN 1         // waiting for the start block token
+#define DATA 2          // reading the block and its CRC
+
+
+struct sdspiStats sdspiStats;
+
+
+static FILE *image = 0;
+static const char *file = 0;
+
+
+// Card state.
+static uint8_t selected = 0, idle = 1, appCommand = 0, state = COMMAND;
+static uint64_t readyAt = 0, busyUntil = 0;
+
+
+// Command being read and the response being sent.
+static uint8_t frame[6], frameLength = 0;
+static uint8_t response[8], responseLength = 0, responseNext = 0;
+
+
+// Block being written.
+static uint8_t block[BLOCK_SIZE + 2];
+static uint16_t blockLength;
+static uint32_t blockAddress;
+
+
+// Description:
+//      CRC7 of a command, shifted and with the end bit as sent.
+//
+static uint8_t crc7(const uint8_t *data, uint8_t length){
+
+    uint8_t i, bit, crc = 0;
+
+    for (i = 0; i < length; ++i){
+        for (bit = 0x80; bit; bit >>= 1){
+            crc <<= 1;
+            if (!!(data[i] & bit) ^ !!(crc & 0x80)){
+                crc ^= 0x09;
+            }
+        }
+    }
+    return (uint8_t)((crc << 1) | 1);
+}
+
+
+// Description:
+//      Queue a response, after one byte of command response time.
+//
+static void respond(const uint8_t *bytes, uint8_t length){
+    response[0] = 0xFF;
+    memcpy(response + 1, bytes, length);
+    responseLength = length + 1;
+    responseNext = 0;
+}
+
+
+// Description:
+//      Run a complete command frame.
+//
+static void command(void){
+
+    uint8_t cmd = frame[0] & 0x3F, r[5];
+    uint32_t arg = (uint32_t)frame[1] << 24 | (uint32_t)frame[2] << 16 |
+                   (uint32_t)frame[3] << 8 | frame[4];
+    uint8_t app = appCommand;
+
+    appCommand = 0;
+    ++sdspiStats.commands;
+    r[0] = idle ? R1_IDLE : 0;
+
+    if ((cmd == CMD0 || cmd == CMD8) && crc7(frame, 5) != frame[5]){
+        r[0] |= R1_CRC;
+        respond(r, 1);
+        return;
+    }
+    if (app && cmd == ACMD41){
+        if (!readyAt){
+            readyAt = simCycles + INIT_CYCLES;
+        }
+        if (simCycles >= readyAt && arg & 0x40000000){
+            idle = 0;
+        }
+        r[0] = idle ? R1_IDLE : 0;
+        respond(r, 1);
+        return;
+    }
+    switch (cmd){
+        case CMD0:
+            idle = 1;
+            readyAt = 0;
+            r[0] = R1_IDLE;
+            respond(r, 1);
+            return;
+        case CMD8:
+            r[1] = 0;
+            r[2] = 0;
+            r[3] = frame[3] & 0x0F;
+            r[4] = frame[4];
+            respond(r, 5);
+            return;
+        case CMD55:
+            appCommand = 1;
+            respond(r, 1);
+            return;
+        case CMD58:
+            r[1] = idle ? 0x40 : 0xC0;  // CCS, power up done once ready
+            r[2] = 0xFF;
+            r[3] = 0x80;
+            r[4] = 0;
+            respond(r, 5);
+            return;
+        case CMD16:
+            r[0] |= arg == BLOCK_SIZE ? 0 : R1_ILLEGAL;
+            respond(r, 1);
+            return;
+        case CMD24:
+            if (!idle){
+                blockAddress = arg;
+                state = TOKEN;
+            } else {
+                r[0] |= R1_ILLEGAL;
+            }
+            respond(r, 1);
+            return;
+    }
+    r[0] |= R1_ILLEGAL;
+    respond(r, 1);
+}
+
+
+// Description:
+//      Write the received block to the image.
+//
+static void writeBlock(void){
+    ++sdspiStats.blocks;
+    if (fseek(image, (long)blockAddress*BLOCK_SIZE, SEEK_SET) ||
+        fwrite(block, 1, BLOCK_SIZE, image) != BLOCK_SIZE){
+        perror(file);
+        ++sdspiStats.errors;
+    }
+    busyUntil = simCycles + PROGRAM_CYCLES;
+}
+
+
+void sdspiInit(const char *path){
+
+    memset(&sdspiStats, 0, sizeof(sdspiStats));
+    file = path;
+    if (!(image = fopen(file, "r+b")) && !(image = fopen(file, "w+b"))){
+        perror(file);
+    }
+}
+
+
+void sdspiClose(void){
+    if (image){
+        fclose(image);
+        image = 0;
+    }
+}
+
+
+void sdspiSelect(void){
+    selected = 1;
+    frameLength = 0;
+    responseLength = 0;
+    state = COMMAND;
+}
+
+
+void sdspiDeselect(void){
+    selected = 0;
+}
+
+
+uint8_t sdspiExchange(uint8_t out){
+
+    if (!selected || !image){
+        return 0xFF;
+    }
+
+    // Shift out a queued response, the host may send anything.
+    if (responseNext < responseLength){
+        return response[responseNext++];
+    }
+
+    switch (state){
+
+        case TOKEN:
+            if (out == TOKEN_START){
+                state = DATA;
+                blockLength = 0;
+            }
+            return 0xFF;
+
+        case DATA:
+            block[blockLength++] = out;
+            if (blockLength == sizeof(block)){
+                writeBlock();
+                state = COMMAND;
+                response[0] = DATA_ACCEPTED;
+                responseLength = 1;
+                responseNext = 0;
+            }
+            return 0xFF;
+    }
+
+    // Data out is held low while programming.
+    if (simCycles < busyUntil){
+        return 0x00;
+    }
+
+    // Commands start with a zero bit followed by a one bit.
+    if (frameLength == 0 && (out & 0xC0) != 0x40){
+        return 0xFF;
+    }
+    frame[frameLength++] = out;
+    if (frameLength == sizeof(frame)){
+        frameLength = 0;
+        command();
+    }
+    return 0xFF;
+}
@@ -0,0 +1,960 @@
+////////////////////////////////////////////////////////////////////////
+// File: sim.c
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Register file, virtual clock, peripherals and interrupts of the
+//      host simulator, and the command line harness that runs main()
+//      and reports frame rate, interrupt load and startup time.
+//
+//      The clock advances by a fixed number of instruction cycles per
+//      basic block of firmware (--block-cycles), by the SPI byte time
+//      while waiting on BF, and by the requested time in the delay
+//      functions.  The per block estimate is rough, C18 code averages
+//      somewhere around 6 to 10 instructions per block, so absolute
+//      times are estimates while SPI and timer bound times are close.
+//
+//      Modeled peripherals:
+//          MSSP1/2     SPI master, byte time from SSPM (Timer2 included)
+//          Timer1      free running count for the profiler
+//          Timer2      period, prescale and postscale, sets TMR2IF
+//          EUSART1     transmit only, TX1IF and TRMT with byte timing
+//          INT2        edge on the LSM303D INT2 pin, sets INT2IF
+//          RB0         calibration button S1, held low for a moment at
+//                      each --press time
+//          Interrupts  IPEN priority levels, GIEH/GIEL, high priority
+//                      can preempt low priority
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <time.h>
+#include <p18cxxx.h>
+#include <delays.h>
+#include "config.h"
+#include "sched.h"
+#include "sim.h"
+
+
+// Interrupt entry and exit overhead in cycles (vector, context save
+// and restore, retfie), C18 saves more for the low priority handler.
+#define ISRH_OVERHEAD 12
+#define ISRL_OVERHEAD 40
+
+
+// Longest simDelay step, so interrupts are taken on time.
+#define DELAY_STEP 64
+
+
+// Number of SPI1 chip selects on LATH.
+#define SPI1_DEVICES 5
+
+
+// Plain registers.
+volatile uint8_t INTCON, INTCON2, INTCON3, RCON;
+volatile uint8_t PIR1, PIE1, IPR1, PIR2, PIE2, IPR2;
+volatile uint8_t T1CON, T1GCON, TMR1H, T2CON, TMR2, PR2;
+volatile uint8_t TXSTA1, RCSTA1, BAUDCON1, SPBRG1, SPBRGH1;
+volatile uint8_t LATB, LATC, LATD, LATJ;
+volatile uint8_t TRISB, TRISC, TRISD, TRISF, TRISH, TRISJ;
+volatile uint8_t PORTB, PORTC;
+
+
+// The bit field views overlay these bytes.
+_Static_assert(sizeof(INTCONbits_t) == 1 && sizeof(INTCON2bits_t) == 1 &&
+               sizeof(INTCON3bits_t) == 1 && sizeof(RCONbits_t) == 1 &&
+               sizeof(PIR1bits_t) == 1 && sizeof(SSPCON1bits_t) == 1 &&
+               sizeof(T1CONbits_t) == 1 && sizeof(T2CONbits_t) == 1 &&
+               sizeof(TXSTAbits_t) == 1 && sizeof(LATHbits_t) == 1 &&
+               sizeof(PORTBbits_t) == 1,
+               "register bit field views must be one byte");
+
+
+// Registers behind the access hooks.
+static volatile uint8_t latF, latH;
+
+
+// Firmware entry points (main is renamed when compiling the firmware).
+void firmwareMain(void);
+void isrh(void);
+void isrl(void);
+
+
+// Firmware statistics, weak so the simulator links with any set of
+// features enabled in config.h.
+extern uint16_t bootTime __attribute__((weak));
+extern int16_t renderHeadroomMin __attribute__((weak));
+extern uint8_t efisLayers __attribute__((weak));
+extern uint16_t telemetryDrops __attribute__((weak));
+extern uint32_t recorderBlocks __attribute__((weak));
+extern uint16_t recorderDrops __attribute__((weak));
+extern uint16_t recorderErrors __attribute__((weak));
+extern uint16_t scrollFrames __attribute__((weak));
+extern uint16_t scrollScrolled __attribute__((weak));
+extern uint8_t frameBuffer[] __attribute__((weak));
+
+
+// Display RAM checked against the frame buffer after each render.
+static int renderTask = -1;
+static uint16_t renderRuns = 0;
+static uint32_t framesChecked = 0, framesWrong = 0;
+
+
+// Virtual time.
+uint64_t simCycles = 0;
+static uint64_t endCycles;
+static uint32_t blockCycles = 8;
+static jmp_buf endJump;
+
+
+// Interrupt state.
+static uint8_t level = 0;   // 0 main line, 1 low, 2 high priority
+static uint64_t isrhCycles = 0, isrlCycles = 0;
+static uint32_t isrhCount = 0, isrlCount = 0;
+static uint32_t isrlMax = 0;
+static uint8_t int2Pin = 0;
+
+
+// Button presses, RB0 is held low for BUTTON_MS after each.
+#define BUTTON_MS 200
+#define MAX_PRESSES 8
+static uint64_t presses[MAX_PRESSES];
+static uint8_t pressCount = 0;
+
+
+// MSSP modules.  A BUF access can be a read or a write, the hook can't
+// tell which.  With BF set it is taken as a read.  Otherwise the hook
+// returns a slot holding the received byte and the access is taken as
+// a write when the next access is to STAT or CON1 (the firmware checks
+// WCOL or polls BF after every write), and as a read when it is another
+// BUF access.
+struct ssp {
+    volatile uint8_t stat, con1;
+    volatile uint8_t slots[4];
+    uint8_t next;
+    volatile uint8_t *candidate;    // slot of a possible write
+    uint8_t rx;                     // last received byte
+    uint8_t busy;
+    uint64_t done;                  // end of the transfer
+    uint32_t bytes, collisions;
+};
+static struct ssp ssp[2];
+#define STATbits(s) (*(volatile SSPSTATbits_t *)&(s)->stat)
+#define CON1bits(s) (*(volatile SSPCON1bits_t *)&(s)->con1)
+
+
+// SPI1 devices by LATH chip select pin, unmodeled ones have no
+// functions.
+struct device {
+    uint8_t pin;
+    const char *name;
+    void (*select)(void);
+    void (*deselect)(void);
+    uint8_t (*exchange)(uint8_t out);
+    uint32_t bytes;
+};
+static struct device spi1Devices[SPI1_DEVICES] = {
+    {5, "imu", lsm303dSelect, lsm303dDeselect, lsm303dExchange, 0},
+    {4, "eeprom", eeprom25Select, eeprom25Deselect, eeprom25Exchange, 0},
+    {0, "sdcard", sdspiSelect, sdspiDeselect, sdspiExchange, 0},
+    {3, "dac", 0, 0, 0, 0},
+    {6, "pressure", 0, 0, 0, 0},
+};
+static uint32_t spi1Conflicts = 0;
+static uint8_t latHSeen = 0xFF, latFSeen = 0xFF;
+
+
+// Timer1.
+static volatile uint8_t tmr1Slots[2];
+static uint8_t tmr1Next = 0, tmr1Handed = 0;
+static volatile uint8_t *tmr1Slot = 0;
+static uint64_t tmr1Base = 0;
+static uint16_t tmr1Start = 0;
+static uint8_t tmr1On = 0;
+
+
+// Timer2.
+static uint64_t tmr2Last = 0;
+static uint64_t tmr2Acc = 0;
+static uint8_t tmr2Post = 0;
+static uint64_t tmr2Raised = 0;    // when TMR2IF was last set
+static uint32_t tmr2Lost = 0;      // interrupts lost, TMR2IF was set
+
+
+// Scheduler log (--sched-log), the tasks are run through wrappers that
+// log each run.
+static FILE *schedLog = 0;
+static void (*taskRuns[SCHED_MAX_TASKS])(void);
+static uint8_t tasksWrapped = 0;
+static uint32_t ticksLogged = 0;
+
+
+// EUSART1 transmitter.
+static volatile uint8_t txregSlot;
+static uint8_t txregPending = 0;
+static uint8_t txregFull = 0;
+static uint8_t tsrBusy = 0;
+static uint64_t tsrDone = 0;
+static uint32_t uartBytes = 0, uartOverwrites = 0;
+static FILE *uartFile = 0;
+
+
+// Description:
+//      Cycles to shift one SPI byte with the current SSPM setting.
+//
+static uint32_t sspByteCycles(struct ssp *s){
+    static const uint16_t prescale[4] = {1, 4, 16, 16};
+    switch (CON1bits(s).SSPM){
+        case 0x0: return 8;     // Fosc/4
+        case 0xA: return 16;    // Fosc/8
+        case 0x1: return 32;    // Fosc/16
+        case 0x2: return 128;   // Fosc/64
+        case 0x3:               // Timer2 output/2
+            return 16UL*(PR2 + 1)*prescale[T2CONbits.T2CKPS];
+        default: return 8;
+    }
+}
+
+
+// Description:
+//      Track chip select edges on LATH and LATF.
+//
+static void sampleSelects(void){
+
+    uint8_t i, pin, changed;
+    struct device *d;
+
+    changed = latHSeen ^ latH;
+    for (i = 0; i < SPI1_DEVICES; ++i){
+        d = &spi1Devices[i];
+        pin = 1 << d->pin;
+        if (!(changed & pin) || !d->exchange){
+            continue;
+        }
+        if (latH & pin){
+            d->deselect();
+        } else {
+            d->select();
+        }
+    }
+    latHSeen = latH;
+
+    changed = latFSeen ^ latF;
+    if (changed & 0x04 && latF & 0x04){
+        ssd1306Reset();             // reset released
+    }
+    if (changed & 0x20){
+        if (latF & 0x20){
+            ssd1306Deselect();
+        } else {
+            ssd1306Select();
+        }
+    }
+    latFSeen = latF;
+}
+
+
+// Description:
+//      Exchange a byte with the device selected on an SPI port.
+//
+static uint8_t sspDevice(uint8_t port, uint8_t out){
+
+    uint8_t i, count = 0;
+    struct device *selected = 0;
+
+    sampleSelects();
+    if (port == 1){
+        return latF & 0x20 ? 0xFF : ssd1306Exchange(out, latF & 0x40);
+    }
+    for (i = 0; i < SPI1_DEVICES; ++i){
+        if (!(latH & (1 << spi1Devices[i].pin))){
+            selected = &spi1Devices[i];
+            ++count;
+        }
+    }
+    if (count > 1){
+        ++spi1Conflicts;
+        return 0xFF;
+    }
+    if (!selected){
+        return 0xFF;
+    }
+    ++selected->bytes;
+    return selected->exchange ? selected->exchange(out) : 0xFF;
+}
+
+
+// Description:
+//      Finish a transfer whose time is up.
+//
+static void sspUpdate(struct ssp *s){
+    if (s->busy && simCycles >= s->done){
+        s->busy = 0;
+        if (STATbits(s).BF){
+            CON1bits(s).SSPOV = 1;
+        }
+        STATbits(s).BF = 1;
+    }
+}
+
+
+// Description:
+//      Start a transfer if the last BUF access was a write.
+//
+static void sspCommit(struct ssp *s){
+
+    uint8_t port = s == &ssp[1];
+
+    if (!s->candidate){
+        return;
+    }
+    if (!CON1bits(s).SSPEN){
+        s->candidate = 0;
+        return;
+    }
+    if (s->busy){
+        CON1bits(s).WCOL = 1;
+        ++s->collisions;
+    } else {
+        s->busy = 1;
+        s->done = simCycles + sspByteCycles(s);
+        s->rx = sspDevice(port, *s->candidate);
+        ++s->bytes;
+    }
+    s->candidate = 0;
+}
+
+
+volatile uint8_t *simSspBuf(uint8_t port){
+
+    struct ssp *s = &ssp[port];
+    volatile uint8_t *slot;
+
+    sspUpdate(s);
+
+    // A candidate followed by another BUF access was a read.
+    s->candidate = 0;
+    slot = &s->slots[s->next++ & 3];
+    *slot = s->rx;
+    if (STATbits(s).BF){
+        // Reading the received byte.
+        STATbits(s).BF = 0;
+        return slot;
+    }
+    s->candidate = slot;
+    return slot;
+}
+
+
+volatile uint8_t *simSspStat(uint8_t port){
+    sspCommit(&ssp[port]);
+    sspUpdate(&ssp[port]);
+    return &ssp[port].stat;
+}
+
+
+volatile uint8_t *simSspCon1(uint8_t port){
+    sspCommit(&ssp[port]);
+    sspUpdate(&ssp[port]);
+    return &ssp[port].con1;
+}
+
+
+volatile uint8_t *simLatF(void){
+    sampleSelects();
+    return &latF;
+}
+
+
+volatile uint8_t *simLatH(void){
+    sampleSelects();
+    return &latH;
+}
+
+
+// Description:
+//      Current Timer1 count.
+//
+static uint16_t tmr1Count(void){
+    if (!tmr1On){
+        return tmr1Start;
+    }
+    return tmr1Start +
+        (uint16_t)((simCycles - tmr1Base) >> T1CONbits.T1CKPS);
+}
+
+
+// Description:
+//      Pick up writes to TMR1L and TMR1ON changes.
+//
+static void tmr1Update(void){
+    if (tmr1Slot && *tmr1Slot != tmr1Handed){
+        tmr1Start = (uint16_t)TMR1H << 8 | *tmr1Slot;
+        tmr1Base = simCycles;
+    }
+    tmr1Slot = 0;
+    if (T1CONbits.TMR1ON != tmr1On){
+        tmr1Start = tmr1Count();
+        tmr1On = T1CONbits.TMR1ON;
+        tmr1Base = simCycles;
+    }
+}
+
+
+volatile uint8_t *simTmr1L(void){
+
+    uint16_t count;
+
+    tmr1Update();
+    count = tmr1Count();
+    if (tmr1On && T1CONbits.RD16){
+        TMR1H = count >> 8;     // latched on reading TMR1L
+    }
+    tmr1Slot = &tmr1Slots[tmr1Next++ & 1];
+    tmr1Handed = *tmr1Slot = (uint8_t)count;
+    return tmr1Slot;
+}
+
+
+// Description:
+//      Advance Timer2 to the current time.
+//
+static void tmr2Update(void){
+
+    static const uint16_t prescale[4] = {1, 4, 16, 16};
+    uint32_t period;
+
+    if (!T2CONbits.TMR2ON){
+        tmr2Last = simCycles;
+        return;
+    }
+    tmr2Acc += simCycles - tmr2Last;
+    tmr2Last = simCycles;
+    period = (uint32_t)(PR2 + 1)*prescale[T2CONbits.T2CKPS];
+    while (tmr2Acc >= period){
+        tmr2Acc -= period;
+        if (++tmr2Post > T2CONbits.T2OUTPS){
+            tmr2Post = 0;
+            if (PIR1bits.TMR2IF && PIE1bits.TMR2IE){
+                ++tmr2Lost;
+            }
+            PIR1bits.TMR2IF = 1;
+            tmr2Raised = simCycles - tmr2Acc;
+        }
+    }
+    TMR2 = (uint8_t)(tmr2Acc/prescale[T2CONbits.T2CKPS]);
+}
+
+
+// Description:
+//      Cycles to send one byte (start, 8 data and stop bits).
+//
+static uint32_t uartByteCycles(void){
+
+    uint32_t brg, divider;
+
+    brg = (uint32_t)SPBRGH1 << 8 | SPBRG1;
+    if (!BAUDCON1bits.BRG16){
+        brg &= 0xFF;
+    }
+    if (BAUDCON1bits.BRG16 && TXSTA1bits.BRGH){
+        divider = 4;
+    } else if (BAUDCON1bits.BRG16 || TXSTA1bits.BRGH){
+        divider = 16;
+    } else {
+        divider = 64;
+    }
+    return 10*divider*(brg + 1)/4;
+}
+
+
+volatile uint8_t *simTxreg1(void){
+    txregPending = 1;
+    return &txregSlot;
+}
+
+
+// Description:
+//      Advance the transmitter and pick up writes to TXREG1.
+//
+static void uartUpdate(void){
+
+    if (tsrBusy && simCycles >= tsrDone){
+        tsrBusy = 0;
+        if (txregFull){
+            txregFull = 0;
+            tsrBusy = 1;
+            tsrDone += uartByteCycles();
+        }
+    }
+    if (txregPending){
+        txregPending = 0;
+        if (TXSTA1bits.TXEN && RCSTA1bits.SPEN){
+            ++uartBytes;
+            if (uartFile){
+                fputc(txregSlot, uartFile);
+            }
+            if (!tsrBusy){
+                tsrBusy = 1;
+                tsrDone = simCycles + uartByteCycles();
+            } else {
+                if (txregFull){
+                    ++uartOverwrites;
+                }
+                txregFull = 1;
+            }
+        }
+    }
+    PIR1bits.TX1IF = TXSTA1bits.TXEN && !txregFull;
+    TXSTA1bits.TRMT = !tsrBusy;
+}
+
+
+// Description:
+//      Sample the IMU interrupt pin and set INT2IF on the active edge.
+//
+static void int2Update(void){
+
+    uint8_t pin;
+
+    lsm303dStep();
+    pin = (uint8_t)lsm303dInt2();
+    if (pin != int2Pin && pin == INTCON2bits.INTEDG2){
+        INTCON3bits.INT2IF = 1;
+    }
+    int2Pin = pin;
+}
+
+
+// Description:
+//      Run an interrupt handler at a priority level.
+//
+static void interrupt(uint8_t priority){
+
+    uint8_t saved = level, tick;
+    uint64_t start = simCycles, nested = isrhCycles, spent;
+
+    level = priority;
+    if (priority == 2){
+        tick = PIR1bits.TMR2IF && PIE1bits.TMR2IE && IPR1bits.TMR2IP;
+        INTCONbits.GIEH = 0;
+        simCycles += ISRH_OVERHEAD;
+        isrh();
+        INTCONbits.GIEH = 1;
+        if (schedLog && tick && !PIR1bits.TMR2IF){
+            fprintf(schedLog, "tick %u %llu %llu\n", ++ticksLogged,
+                    (unsigned long long)tmr2Raised,
+                    (unsigned long long)start);
+        }
+        isrhCycles += simCycles - start;
+        ++isrhCount;
+    } else {
+        INTCONbits.GIEL = 0;
+        simCycles += ISRL_OVERHEAD;
+        isrl();
+        INTCONbits.GIEL = 1;
+        spent = simCycles - start - (isrhCycles - nested);
+        isrlCycles += spent;
+        if (spent > isrlMax){
+            isrlMax = (uint32_t)spent;
+        }
+        ++isrlCount;
+    }
+    level = saved;
+}
+
+
+// Description:
+//      Drive the calibration button from the --press times.
+//
+static void buttonUpdate(void){
+
+    uint8_t i;
+
+    PORTB |= 0x01;
+    for (i = 0; i < pressCount; ++i){
+        if (simCycles >= presses[i] &&
+                simCycles < presses[i] + BUTTON_MS*(SIM_FCY/1000)){
+            PORTB &= ~0x01;
+        }
+    }
+}
+
+
+// Description:
+//      Run a wrapped task and log its release tick, start and end.
+//
+// Input:
+//      uint8_t i:
+//          Index of the task in schedTasks.
+//
+static void taskRun(uint8_t i){
+
+    uint16_t release = schedTasks[i].release;
+    uint64_t start = simCycles;
+
+    taskRuns[i]();
+    fprintf(schedLog, "run %u %u %llu %llu\n", i, release,
+            (unsigned long long)start, (unsigned long long)simCycles);
+}
+
+
+#define SIM_TASK(n) static void simTask##n(void){ taskRun(n); }
+SIM_TASK(0)
+SIM_TASK(1)
+SIM_TASK(2)
+SIM_TASK(3)
+static void (*const simTasks[])(void) = {
+    simTask0, simTask1, simTask2, simTask3
+};
+_Static_assert(sizeof(simTasks)/sizeof(simTasks[0]) == SCHED_MAX_TASKS,
+               "one wrapper per scheduler task");
+
+
+// Description:
+//      Wrap tasks added since the last call and log their settings.
+//
+static void schedWrap(void){
+
+    uint8_t i;
+
+    while (tasksWrapped < schedTaskCount){
+        i = tasksWrapped++;
+        taskRuns[i] = schedTasks[i].run;
+        schedTasks[i].run = simTasks[i];
+        fprintf(schedLog, "task %u %u %u %u\n", i, schedTasks[i].period,
+                schedTasks[i].deadline, schedTasks[i].release);
+    }
+}
+
+
+// Description:
+//      After each run of the render task check that the display shows
+//      the frame buffer.
+//
+static void renderCheck(void){
+
+    uint8_t i;
+
+    if (renderTask < 0){
+        for (i = 0; i < schedTaskCount; ++i){
+            if (schedTasks[i].period == RENDER_PERIOD){
+                renderTask = i;
+            }
+        }
+        return;
+    }
+    if (schedTasks[renderTask].runs != renderRuns && frameBuffer){
+        renderRuns = schedTasks[renderTask].runs;
+        ++framesChecked;
+        framesWrong += ssd1306Compare(frameBuffer) != 0;
+    }
+}
+
+
+void simPoll(void){
+
+    uint8_t high, low;
+
+    if (simCycles >= endCycles){
+        longjmp(endJump, 1);
+    }
+    renderCheck();
+    if (schedLog){
+        schedWrap();
+    }
+
+    // Peripherals.
+    sampleSelects();
+    sspUpdate(&ssp[0]);
+    sspUpdate(&ssp[1]);
+    tmr1Update();
+    tmr2Update();
+    uartUpdate();
+    int2Update();
+    buttonUpdate();
+
+    // Interrupts, only priority mode is modeled.
+    if (level == 2 || !RCONbits.IPEN || !INTCONbits.GIEH){
+        return;
+    }
+    high = (PIR1bits.TMR2IF && PIE1bits.TMR2IE && IPR1bits.TMR2IP) ||
+           (PIR1bits.TX1IF && PIE1bits.TX1IE && IPR1bits.TX1IP) ||
+           (INTCON3bits.INT2IF && INTCON3bits.INT2IE && INTCON3bits.INT2IP);
+    if (high){
+        interrupt(2);
+        return;
+    }
+    if (level == 1 || !INTCONbits.GIEL){
+        return;
+    }
+    low = (PIR1bits.TMR2IF && PIE1bits.TMR2IE && !IPR1bits.TMR2IP) ||
+          (PIR1bits.TX1IF && PIE1bits.TX1IE && !IPR1bits.TX1IP) ||
+          (INTCON3bits.INT2IF && INTCON3bits.INT2IE && !INTCON3bits.INT2IP);
+    if (low){
+        interrupt(1);
+    }
+}
+
+
+void simDelay(uint32_t cycles){
+
+    uint32_t step;
+
+    while (cycles > 0){
+        step = cycles < DELAY_STEP ? cycles : DELAY_STEP;
+        simCycles += step;
+        cycles -= step;
+        simPoll();
+    }
+}
+
+
+char *strncpypgm2ram(char *dest, const char *src, size_t n){
+    return strncpy(dest, src, n);
+}
+
+
+// Description:
+//      Basic block hook inserted by -fsanitize-coverage=trace-pc.
+//
+void __sanitizer_cov_trace_pc(void){
+    simCycles += blockCycles;
+    simPoll();
+}
+
+
+// Description:
+//      Print what the run measured.
+//
+static void report(double hostSeconds){
+
+    uint8_t i;
+    double seconds = simSeconds(simCycles);
+    struct ssd1306Stats *o = &ssd1306Stats;
+    struct lsm303dStats *m = &lsm303dStats;
+
+    printf("simulated %.3f s in %.3f s host time (%.1fx)\n",
+           seconds, hostSeconds, hostSeconds > 0 ? seconds/hostSeconds : 0);
+
+    printf("\nstartup\n");
+    if (o->frames > 0){
+        printf("  first frame (splash)  %8.1f ms\n",
+               simSeconds(o->firstFrame)*1e3);
+    }
+    if (o->frames > 1){
+        printf("  second frame          %8.1f ms\n",
+               simSeconds(o->secondFrame)*1e3);
+    }
+    if (&bootTime){
+        printf("  bootTime              %8u ms after interrupts on\n",
+               bootTime);
+    }
+
+    printf("\noled\n");
+    printf("  frames                %8u\n", o->frames);
+    if (o->frames > 2){
+        printf("  frame rate            %8.2f Hz (after splash)\n",
+               (o->frames - 2)/simSeconds(o->lastFrame - o->secondFrame));
+        printf("  frame interval        %8.2f .. %.2f ms\n",
+               simSeconds(o->minGap)*1e3, simSeconds(o->maxGap)*1e3);
+    }
+    printf("  commands, data bytes  %8u %u\n", o->commands, o->dataBytes);
+    printf("  selects               %8u\n", o->selects);
+    printf("  renders checked, wrong %7u %u\n", framesChecked, framesWrong);
+    if (&scrollFrames){
+        printf("  scrolled frames       %8u of %u\n", scrollScrolled,
+               scrollFrames);
+    }
+
+    printf("\ninterrupts\n");
+    printf("  high  %8u calls  %6.2f %% load\n", isrhCount,
+           100.0*isrhCycles/simCycles);
+    printf("  low   %8u calls  %6.2f %% load  %.1f us longest\n", isrlCount,
+           100.0*isrlCycles/simCycles, simSeconds(isrlMax)*1e6);
+
+    printf("\nspi\n");
+    printf("  spi1 %9u bytes  %u collisions  %u select conflicts\n",
+           ssp[0].bytes, ssp[0].collisions, spi1Conflicts);
+    for (i = 0; i < SPI1_DEVICES; ++i){
+        if (spi1Devices[i].bytes){
+            printf("    %-9s %9u%s\n", spi1Devices[i].name,
+                   spi1Devices[i].bytes,
+                   spi1Devices[i].exchange ? "" : " (not modeled)");
+        }
+    }
+    printf("  spi2 %9u bytes  %u collisions\n", ssp[1].bytes,
+           ssp[1].collisions);
+
+    printf("\nimu\n");
+    printf("  acc  %6u samples  %6u read  %4u overruns\n",
+           m->accSamples, m->accReads, m->accOverruns);
+    printf("  mag  %6u samples  %6u read  %4u overruns\n",
+           m->magSamples, m->magReads, m->magOverruns);
+    if (int2Pin){
+        printf("  INT2 pin is high at the end of the run\n");
+    }
+
+    printf("\nuart\n");
+    printf("  %u bytes  %u overwritten\n", uartBytes, uartOverwrites);
+    if (&telemetryDrops){
+        printf("  telemetryDrops %u\n", telemetryDrops);
+    }
+
+    printf("\nscheduler (ticks of %d ms)\n", SCHED_TICK_MS);
+    for (i = 0; i < schedTaskCount; ++i){
+        printf("  task %u  period %3u  runs %6u  max %3u  overruns %u\n",
+               i, schedTasks[i].period, schedTasks[i].runs,
+               schedTasks[i].max, schedTasks[i].overruns);
+    }
+    if (tmr2Lost){
+        printf("  %u timer 2 ticks lost\n", tmr2Lost);
+    }
+    if (&renderHeadroomMin){
+        printf("  renderHeadroomMin %d ms\n", renderHeadroomMin);
+    }
+    if (&efisLayers){
+        printf("  efisLayers 0x%02X\n", efisLayers);
+    }
+    if (&recorderBlocks){
+        printf("  recorderBlocks %u  recorderDrops %u  recorderErrors %u\n",
+               recorderBlocks, recorderDrops, recorderErrors);
+    }
+    if (sdspiStats.commands){
+        printf("\nsdcard\n");
+        printf("  %u commands  %u blocks written  %u write errors\n",
+               sdspiStats.commands, sdspiStats.blocks, sdspiStats.errors);
+    }
+}
+
+
+// Description:
+//      Run the firmware until the simulated time is up.  Kept out of
+//      main so its locals are not live across the longjmp.
+//
+static void run(void){
+    if (!setjmp(endJump)){
+        firmwareMain();
+        fprintf(stderr, "main() returned\n");
+    }
+}
+
+
+static void usage(const char *name){
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --time SECONDS        simulated time (10)\n"
+        "  --motion FILE         motion script, lines of t roll pitch yaw\n"
+        "                        in seconds and degrees\n"
+        "  --noise COUNTS        accelerometer noise (30)\n"
+        "  --seed N              noise seed (1)\n"
+        "  --block-cycles N      cycles per basic block (8)\n"
+        "  --oled FILE           write the last display image (PBM)\n"
+        "  --frames DIR          write every frame to DIR (PBM)\n"
+        "  --frame-every N       only every Nth frame (1)\n"
+        "  --oled-log FILE       write the decoded OLED commands\n"
+        "  --uart FILE           write the EUSART output\n"
+        "  --eeprom FILE         EEPROM image, loaded and saved\n"
+        "  --sdcard FILE         SD card image, written in place (no\n"
+        "                        card without it)\n"
+        "  --sched-log FILE      write task releases and runs and timer\n"
+        "                        ticks\n"
+        "  --press MS            press the calibration button at MS,\n"
+        "                        up to %d times\n",
+        name, MAX_PRESSES);
+    exit(2);
+}
+
+
+int main(int argc, char **argv){
+
+    int i;
+    double seconds = 10.0, noise = 30.0;
+    uint32_t seed = 1, frameEvery = 1;
+    const char *motion = 0, *oled = 0, *frames = 0, *uart = 0;
+    const char *eeprom = 0, *oledLog = 0, *sched = 0, *sdcard = 0;
+    clock_t start;
+
+    for (i = 1; i < argc; ++i){
+        const char *arg = argv[i], *value = i + 1 < argc ? argv[i+1] : 0;
+        if (!strcmp(arg, "-h") || !strcmp(arg, "--help") || !value){
+            usage(argv[0]);
+        }
+        ++i;
+        if (!strcmp(arg, "--time")) seconds = atof(value);
+        else if (!strcmp(arg, "--motion")) motion = value;
+        else if (!strcmp(arg, "--noise")) noise = atof(value);
+        else if (!strcmp(arg, "--seed")) seed = strtoul(value, 0, 0);
+        else if (!strcmp(arg, "--block-cycles"))
+            blockCycles = strtoul(value, 0, 0);
+        else if (!strcmp(arg, "--oled")) oled = value;
+        else if (!strcmp(arg, "--frames")) frames = value;
+        else if (!strcmp(arg, "--frame-every"))
+            frameEvery = strtoul(value, 0, 0);
+        else if (!strcmp(arg, "--oled-log")) oledLog = value;
+        else if (!strcmp(arg, "--uart")) uart = value;
+        else if (!strcmp(arg, "--eeprom")) eeprom = value;
+        else if (!strcmp(arg, "--sdcard")) sdcard = value;
+        else if (!strcmp(arg, "--sched-log")) sched = value;
+        else if (!strcmp(arg, "--press") && pressCount < MAX_PRESSES)
+            presses[pressCount++] = (uint64_t)(atof(value)*SIM_FCY/1000);
+        else usage(argv[0]);
+    }
+
+    // Power on state.
+    latF = latH = 0xFF;
+    TRISB = TRISC = TRISD = TRISF = TRISH = TRISJ = 0xFF;
+    PORTB = 0xFF;
+    PR2 = 0xFF;
+    TXSTA1 = 0x02;  // TRMT
+    INTCON2 = 0xFF;
+    INTCON3 = 0xC0;
+    IPR1 = IPR2 = 0xFF;
+
+    lsm303dInit(motion, noise, seed);
+    ssd1306Init(frames, frameEvery ? frameEvery : 1, oledLog);
+    eeprom25Init(eeprom);
+    if (sdcard){
+        sdspiInit(sdcard);
+    }
+    if (uart && !(uartFile = fopen(uart, "wb"))){
+        perror(uart);
+        return 1;
+    }
+    if (sched && !(schedLog = fopen(sched, "w"))){
+        perror(sched);
+        return 1;
+    }
+
+    endCycles = (uint64_t)(seconds*SIM_FCY);
+    start = clock();
+    run();
+    report((double)(clock() - start)/CLOCKS_PER_SEC);
+
+    if (oled && ssd1306WritePbm(oled)){
+        perror(oled);
+    }
+    ssd1306Close();
+    eeprom25Save();
+    sdspiClose();
+    if (uartFile){
+        fclose(uartFile);
+    }
+    if (schedLog){
+        for (i = 0; i < schedTaskCount; ++i){
+            fprintf(schedLog, "stats %d %u %u %u\n", i, schedTasks[i].runs,
+                    schedTasks[i].max, schedTasks[i].overruns);
+        }
+        fprintf(schedLog, "lost %u\nend %llu\n", tmr2Lost,
+                (unsigned long long)simCycles);
+        fclose(schedLog);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////
+// File: sim.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Host simulator of the PIC ADI board (see picsim).  The firmware
+//      is compiled unmodified against the register model in p18cxxx.h
+//      with every basic block instrumented.  Each block advances a
+//      virtual instruction clock by a fixed estimate and gives the
+//      peripherals and interrupts a chance to run, so interrupts land
+//      between blocks much like they land between instructions on the
+//      target.
+//
+//      SPI devices are modeled behaviorally:
+//
+//          SPI1    LSM303D IMU (LATH5), 25xx EEPROM (LATH4), SD card
+//                  (LATH0, when given an image), DAC (LATH3, not
+//                  modeled), pressure sensor (LATH6, not modeled)
+//          SPI2    SSD1306 OLED (select LATF5, data/command LATF6)
+//
+//      Unmodeled devices read as 0xFF, as an empty socket would.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SIM_H
+#define SIM_H
+
+
+#include <stdint.h>
+
+
+// Instruction clock, Fosc/4.
+#define SIM_FCY (2500000UL*PLLMUL)
+
+
+// Virtual time in instruction cycles.
+extern uint64_t simCycles;
+
+
+// Description:
+//      Convert cycles to seconds.
+//
+#define simSeconds(cycles) ((double)(cycles)/SIM_FCY)
+
+
+// Description:
+//      Bring the peripherals up to simCycles and take any pending
+//      interrupts.  Called on every instrumented basic block.
+//
+void simPoll(void);
+
+
+// LSM303D accelerometer/magnetometer (lsm303d.c).
+struct lsm303dStats {
+    uint32_t accSamples, accReads, accOverruns;
+    uint32_t magSamples, magReads, magOverruns;
+};
+extern struct lsm303dStats lsm303dStats;
+void lsm303dInit(const char *motion, double noise, uint32_t seed);
+void lsm303dSelect(void);
+void lsm303dDeselect(void);
+uint8_t lsm303dExchange(uint8_t out);
+void lsm303dStep(void);
+int lsm303dInt2(void);
+
+
+// SSD1306 OLED controller (ssd1306.c).
+struct ssd1306Stats {
+    uint32_t frames, commands, dataBytes, selects;
+    uint64_t firstFrame, secondFrame, lastFrame;
+    uint64_t minGap, maxGap;
+};
+extern struct ssd1306Stats ssd1306Stats;
+void ssd1306Init(const char *frameDir, uint32_t frameEvery,
+                 const char *log);
+void ssd1306Close(void);
+void ssd1306Reset(void);
+void ssd1306Select(void);
+void ssd1306Deselect(void);
+uint8_t ssd1306Exchange(uint8_t out, int data);
+int ssd1306WritePbm(const char *path);
+uint32_t ssd1306Compare(const uint8_t *frame);
+
+
+// 25xx SPI EEPROM (eeprom25.c).
+void eeprom25Init(const char *path);
+void eeprom25Save(void);
+void eeprom25Select(void);
+void eeprom25Deselect(void);
+uint8_t eeprom25Exchange(uint8_t out);
+
+
+// SD card in SPI mode (sdspi.c).
+struct sdspiStats {
+    uint32_t commands, blocks, errors;
+};
+extern struct sdspiStats sdspiStats;
+void sdspiInit(const char *path);
+void sdspiClose(void);
+void sdspiSelect(void);
+void sdspiDeselect(void);
+uint8_t sdspiExchange(uint8_t out);
+
+
+#endif // SIM_H
@@ -0,0 +1,370 @@
+////////////////////////////////////////////////////////////////////////
+// File: ssd1306.c
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: Host
+// Compiler: GCC
+// Description:
+//      Behavioral model of the SSD1306 OLED controller (128x64) for the
+//      host simulator.
+//
+//      Command bytes (D/C low) are decoded with their arguments, the
+//      ones that affect the image (addressing mode, column and page
+//      ranges, start line, display offset, segment and COM remap,
+//      inverse, display on/off) are applied.  Data bytes (D/C high) are
+//      written to GDDRAM in horizontal, vertical or page addressing
+//      mode.
+//
+//      The decoded stream can be logged, one line per command ("C" and
+//      the bytes in hex), a "D" line with the data byte count of a
+//      select and a "CS" line at each deselect, to compare the commands
+//      sent by two builds.
+//
+//      ssd1306Compare checks display RAM against a frame buffer, with the
+//      start line and display offset applied, so partial and scrolled
+//      updates can be checked against the frame the firmware drew.
+//
+//      Every select with data written counts as a frame, selects less
+//      than 2 ms after the last one are parts (partial updates) of the
+//      same frame.  The display
+//      image is what the panel shows, after remapping, so it is in the
+//      orientation of the mounted module.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+#include "sim.h"
+
+
+#define WIDTH 128
+#define HEIGHT 64
+#define PAGES (HEIGHT/8)
+#define FRAME_GAP (SIM_FCY/500)     // 2 ms
+
+
+struct ssd1306Stats ssd1306Stats;
+
+
+// Display RAM and state.
+static uint8_t ram[PAGES][WIDTH];
+static uint8_t mode;                // 0 horizontal, 1 vertical, 2 page
+static uint8_t colStart, colEnd, pageStart, pageEnd;
+static uint8_t col, page;
+static uint8_t startLine, offset;
+static uint8_t segRemap, comReverse, inverse, on, entireOn;
+
+
+// Command being decoded.
+static uint8_t cmd[8];
+static uint8_t cmdLength, cmdNeeded;
+
+
+// Transfer state.
+static uint8_t selected = 0;
+static uint32_t transferData = 0;
+static uint64_t lastData = 0;
+
+
+// Frame output.
+static const char *frameDir = 0;
+static uint32_t frameEvery = 1;
+
+
+// Command log.
+static FILE *logFile = 0;
+
+
+// Description:
+//      Number of argument bytes of a command.
+//
+static uint8_t arguments(uint8_t c){
+    switch (c){
+        case 0x81: case 0x20: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB: case 0x8D:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+
+// Description:
+//      Apply a complete command.
+//
+static void execute(void){
+
+    uint8_t c = cmd[0], i;
+
+    ++ssd1306Stats.commands;
+    if (logFile){
+        fputc('C', logFile);
+        for (i = 0; i < cmdLength; ++i){
+            fprintf(logFile, " %02X", cmd[i]);
+        }
+        fputc('\n', logFile);
+    }
+    if (c <= 0x0F){
+        col = (col & 0xF0) | c;             // page mode lower column
+    } else if (c <= 0x1F){
+        col = (col & 0x0F) | (c & 0x07) << 4;
+    } else if (c == 0x20){
+        mode = cmd[1] & 0x03;
+    } else if (c == 0x21){
+        colStart = cmd[1] & 0x7F;
+        colEnd = cmd[2] & 0x7F;
+        col = colStart;
+    } else if (c == 0x22){
+        pageStart = cmd[1] & 0x07;
+        pageEnd = cmd[2] & 0x07;
+        page = pageStart;
+    } else if (c >= 0x40 && c <= 0x7F){
+        startLine = c & 0x3F;
+    } else if (c == 0xA0 || c == 0xA1){
+        segRemap = c & 1;
+    } else if (c == 0xA4 || c == 0xA5){
+        entireOn = c & 1;
+    } else if (c == 0xA6 || c == 0xA7){
+        inverse = c & 1;
+    } else if (c == 0xAE || c == 0xAF){
+        on = c & 1;
+    } else if (c >= 0xB0 && c <= 0xB7){
+        page = c & 0x07;                    // page mode start page
+    } else if (c == 0xC0 || c == 0xC8){
+        comReverse = c == 0xC8;
+    } else if (c == 0xD3){
+        offset = cmd[1] & 0x3F;
+    }
+}
+
+
+// Description:
+//      Write a byte of display data and advance the address.
+//
+static void data(uint8_t byte){
+
+    ram[page][col] = byte;
+    ++ssd1306Stats.dataBytes;
+    ++transferData;
+
+    switch (mode){
+        case 0:     // horizontal
+            if (col++ >= colEnd){
+                col = colStart;
+                if (page++ >= pageEnd){
+                    page = pageStart;
+                }
+            }
+            break;
+        case 1:     // vertical
+            if (page++ >= pageEnd){
+                page = pageStart;
+                if (col++ >= colEnd){
+                    col = colStart;
+                }
+            }
+            break;
+        default:    // page
+            if (col++ >= WIDTH - 1){
+                col = 0;
+            }
+            break;
+    }
+}
+
+
+// Description:
+//      Pixel as shown by the panel, row 0 at the top.
+//
+static uint8_t pixel(uint8_t x, uint8_t y){
+
+    uint8_t seg, com, row, value;
+
+    if (!on){
+        return 0;
+    }
+    if (entireOn){
+        return 1;
+    }
+    seg = segRemap ? x : WIDTH - 1 - x;
+    com = comReverse ? y : HEIGHT - 1 - y;
+    row = (com + startLine + offset) % HEIGHT;
+    value = (ram[row/8][seg] >> (row % 8)) & 1;
+    return value ^ inverse;
+}
+
+
+// Description:
+//      Write the panel image as a binary PBM.
+//
+static int writePbm(const char *path){
+
+    FILE *f;
+    uint8_t x, y, byte;
+
+    if (!(f = fopen(path, "wb"))){
+        return -1;
+    }
+    fprintf(f, "P4\n%d %d\n", WIDTH, HEIGHT);
+    for (y = 0; y < HEIGHT; ++y){
+        byte = 0;
+        for (x = 0; x < WIDTH; ++x){
+            byte = byte << 1 | pixel(x, y);
+            if (x % 8 == 7){
+                fputc(byte, f);
+                byte = 0;
+            }
+        }
+    }
+    return fclose(f);
+}
+
+
+// Description:
+//      Write the image of a frame to the frame directory.
+//
+static void dumpFrame(uint32_t frame){
+
+    char path[1024];
+
+    if (frameDir && frame % frameEvery == 0){
+        snprintf(path, sizeof(path), "%s/frame%06u.pbm", frameDir, frame);
+        if (writePbm(path)){
+            perror(path);
+        }
+    }
+}
+
+
+void ssd1306Init(const char *dir, uint32_t every, const char *log){
+    frameDir = dir;
+    frameEvery = every;
+    if (log && !(logFile = fopen(log, "w"))){
+        perror(log);
+    }
+    ssd1306Reset();
+}
+
+
+void ssd1306Close(void){
+    if (logFile){
+        fclose(logFile);
+        logFile = 0;
+    }
+}
+
+
+void ssd1306Reset(void){
+    mode = 2;
+    colStart = 0;
+    colEnd = WIDTH - 1;
+    pageStart = 0;
+    pageEnd = PAGES - 1;
+    col = page = 0;
+    startLine = offset = 0;
+    segRemap = comReverse = inverse = on = entireOn = 0;
+    cmdLength = cmdNeeded = 0;
+}
+
+
+void ssd1306Select(void){
+    selected = 1;
+    transferData = 0;
+}
+
+
+void ssd1306Deselect(void){
+
+    struct ssd1306Stats *s = &ssd1306Stats;
+    uint64_t gap;
+
+    selected = 0;
+    ++s->selects;
+    if (logFile){
+        if (transferData){
+            fprintf(logFile, "D %u\n", transferData);
+        }
+        fputs("CS\n", logFile);
+    }
+    if (transferData == 0){
+        return;
+    }
+
+    // Part of the last frame.
+    if (s->frames > 0 && simCycles - lastData < FRAME_GAP){
+        lastData = simCycles;
+        dumpFrame(s->frames - 1);
+        return;
+    }
+    lastData = simCycles;
+
+    // Frame written.
+    if (s->frames > 1){
+        gap = simCycles - s->lastFrame;
+        if (s->frames == 2 || gap < s->minGap){
+            s->minGap = gap;
+        }
+        if (gap > s->maxGap){
+            s->maxGap = gap;
+        }
+    }
+    if (s->frames == 0){
+        s->firstFrame = simCycles;
+    } else if (s->frames == 1){
+        s->secondFrame = simCycles;
+    }
+    s->lastFrame = simCycles;
+    dumpFrame(s->frames);
+    ++s->frames;
+}
+
+
+uint8_t ssd1306Exchange(uint8_t out, int isData){
+
+    if (!selected){
+        return 0xFF;
+    }
+    if (isData){
+        data(out);
+    } else {
+        cmd[cmdLength++] = out;
+        if (cmdLength == 1){
+            cmdNeeded = 1 + arguments(out);
+        }
+        if (cmdLength == cmdNeeded){
+            execute();
+            cmdLength = 0;
+        }
+    }
+    return 0x00;    // the SSD1306 has no data output
+}
+
+
+int ssd1306WritePbm(const char *path){
+    return writePbm(path);
+}
+
+
+uint32_t ssd1306Compare(const uint8_t *frame){
+
+    uint8_t x, y, row;
+    uint32_t differ = 0;
+
+    for (x = 0; x < WIDTH; ++x){
+        for (y = 0; y < HEIGHT; ++y){
+            row = (y + startLine + offset) % HEIGHT;
+            differ += ((frame[x*PAGES + y/8] >> (y % 8)) & 1) !=
+                      ((ram[row/8][x] >> (row % 8)) & 1);
+        }
+    }
+    return differ;
+}
@@ -16,9 +16,38 @@
 #include "stdint.h"
 #include "mathlib.h"
 #include "imu.h"
+#include "magcal.h"
 #include "ahrs.h"
 
 
+// Description:
+//      Scale a vector to a length of TRIG16_ONE in place.  A zero
+//      length vector is left untouched.
+//
+// Input:
+//      int32_t *x_ptr, *y_ptr, *z_ptr:
+//          Pointers to the components of the vector.  Each component
+//          must be within the range of an int16_t.
+//
+static void ahrsNormalize(int32_t *x_ptr, int32_t *y_ptr, int32_t *z_ptr){
+
+    int32_t n;
+
+    // Compute the length of the vector.
+    n = sqrt32((uint32_t)(*x_ptr * *x_ptr) +
+               (uint32_t)(*y_ptr * *y_ptr) +
+               (uint32_t)(*z_ptr * *z_ptr));
+    if (n == 0){
+        return;
+    }
+
+    // Scale each component.
+    *x_ptr = (*x_ptr*TRIG16_ONE)/n;
+    *y_ptr = (*y_ptr*TRIG16_ONE)/n;
+    *z_ptr = (*z_ptr*TRIG16_ONE)/n;
+}
+
+
 bool ahrsUpdate(int16_t *yaw, int16_t *pitch, int16_t *roll){
 
     int16_t axt, ayt, azt, mxt, myt, mzt;
@@ -82,6 +111,76 @@ bool ahrsUpdate(int16_t *yaw, int16_t *pitch, int16_t *roll){
 }
 
 
+bool ahrsUpdate_(struct attitude *att){
+
+    int16_t axt, ayt, azt, mxt, myt, mzt;
+    int32_t ax, ay, az, mx, my, mz;
+    int32_t rollSin, rollCos, pitchSin, pitchCos, yz;
+    int32_t tmpA, tmpB, tmpC, tmpD, tmpE;
+    bool valid;
+
+    // Read data from IMU and convert to plane based coordinate system.
+    // X forward, Y starbord, and Z down, but invert gravity vector as
+    // well so gravity is positive.
+    ahrsReadAcc(&axt, &ayt, &azt);
+    ahrsReadMag(&mxt, &myt, &mzt);
+    ax = -axt; ay = ayt; az = azt;
+    mx = mxt; my = -myt; mz = -mzt;
+
+    // Check for validity of solution (before normalization).
+    tmpA = (ax*ax)/IMU_ONE + (ay*ay)/IMU_ONE + (az*az)/IMU_ONE;
+    valid = !(tmpA < IMU_ACC_MAG_MIN || IMU_ACC_MAG_MAX < tmpA);
+
+    // Direction of measured gravity.
+    ahrsNormalize(&ax, &ay, &az);
+
+    // Trig functions of roll come from the projection of gravity onto
+    // the y-z plane, pitch is the angle of gravity out of that plane.
+    // Rounding can put the projection of a level unit vector just over
+    // TRIG16_ONE, which atan216 would take as negative.
+    yz = sqrt32((uint32_t)(ay*ay) + (uint32_t)(az*az));
+    if (yz > TRIG16_ONE){
+        yz = TRIG16_ONE;
+    }
+    if (yz == 0){
+        rollSin = 0;
+        rollCos = TRIG16_ONE;
+    } else {
+        rollSin = (ay*TRIG16_ONE)/yz;
+        rollCos = (az*TRIG16_ONE)/yz;
+    }
+    pitchSin = -ax;
+    pitchCos = yz;
+
+    // Calculate the roll angle, limited to -180 to 180.
+    att->roll = atan216(ay, az);
+    if (att->roll > TRIG16_CYCLE/2){
+        att->roll -= TRIG16_CYCLE;
+    }
+
+    // Calculate the pitch angle, which is always within -90 to +90
+    // because yz is never negative.
+    att->pitch = atan216(pitchSin, pitchCos);
+    if (att->pitch > TRIG16_CYCLE/2){
+        att->pitch -= TRIG16_CYCLE;
+    }
+
+    // Calculate the yaw angle.
+    tmpA = (mx*pitchCos)/TRIG16_ONE;
+    tmpB = (mz*pitchSin)/TRIG16_ONE;
+    tmpC = (((mz*rollSin)/TRIG16_ONE)*pitchCos)/TRIG16_ONE;
+    tmpD = (((mx*rollSin)/TRIG16_ONE)*pitchSin)/TRIG16_ONE;
+    tmpE = (my*rollCos)/TRIG16_ONE;
+    att->yaw = atan216(tmpC - tmpD - tmpE, tmpA + tmpB);
+
+    // Store trig functions of roll for the EFIS.
+    att->rollSin = rollSin;
+    att->rollCos = rollCos;
+
+    return valid;
+}
+
+
 void ahrsReadAcc(int16_t *x_ptr, int16_t *y_ptr, int16_t *z_ptr){
 
     uint8_t i;
@@ -147,4 +246,7 @@ void ahrsReadMag(int16_t *x_ptr, int16_t *y_ptr, int16_t *z_ptr){
         }
     );
     *z_ptr = acc/((int32_t)IMU_BUFFER_LENGTH);
+
+    // Correct for hard and soft iron errors.
+    magcalApply(x_ptr, y_ptr, z_ptr);
 }
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////
+// File: anim.c
+// Header: anim.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "oled.h"
+#include "sched.h"
+#include "scroll.h"
+#include "anim.h"
+
+
+// Extern the frame buffer.
+extern uint8_t frameBuffer[OLED_SIZE];
+
+
+// Next frame and the number left.
+static const rom uint8_t *src;
+static uint8_t left = 0;
+
+
+// Ticks between frames and the tick the last frame was shown.
+static uint16_t period;
+static uint16_t shown;
+
+
+// Description:
+//      Decode a keyframe into the frame buffer.  Each packet is a
+//      control byte of 0x80 | (n - 1) followed by a byte repeated n times
+//      or of n - 1 followed by n literal bytes.
+//
+static void __animKey(void){
+
+    uint8_t *dst;
+    uint8_t control, n, value;
+
+    for (dst = frameBuffer; dst < frameBuffer + OLED_SIZE; ){
+        control = *src++;
+        n = (control & 0x7F) + 1;
+        if (control & 0x80){
+            value = *src++;
+            do {
+                *dst++ = value;
+            } while (--n);
+        } else {
+            do {
+                *dst++ = *src++;
+            } while (--n);
+        }
+    }
+}
+
+
+// Description:
+//      Apply a delta to the frame buffer and write the columns and pages
+//      it changed.
+//
+static void __animDelta(void){
+
+    uint16_t idx, end;
+    uint8_t skip, n;
+    uint8_t column0, column1, page0, page1;
+
+    column0 = OLED_WIDTH - 1;
+    column1 = 0;
+    page0 = OLED_HEIGHT/8 - 1;
+    page1 = 0;
+    idx = 0;
+    for (;;){
+        skip = *src++;
+        n = *src++;
+        if (skip == 0 && n == 0){
+            break;
+        }
+        idx += skip;
+        if (n == 0){
+            continue;
+        }
+
+        // Grow the window by the run, all pages if it spans columns.
+        end = idx + n - 1;
+        if ((uint8_t)(idx/8) < column0){
+            column0 = idx/8;
+        }
+        if ((uint8_t)(end/8) > column1){
+            column1 = end/8;
+        }
+        if (idx/8 != end/8){
+            page0 = 0;
+            page1 = OLED_HEIGHT/8 - 1;
+        } else {
+            if ((idx & 7) < page0){
+                page0 = idx & 7;
+            }
+            if ((end & 7) > page1){
+                page1 = end & 7;
+            }
+        }
+
+        // XOR the run in.
+        do {
+            frameBuffer[idx++] ^= *src++;
+        } while (--n);
+    }
+
+    // Write the window, nothing if the frame did not change.
+    if (column0 <= column1){
+        oledWriteRows(column0, column1, page0, page1);
+    }
+}
+
+
+void animStart(const rom struct animation *anim){
+    src = anim->data;
+    left = anim->frames;
+    period = anim->period/SCHED_TICK_MS;
+    shown = schedTicks() - period;
+}
+
+
+bool animStep(void){
+
+    uint16_t now;
+
+    if (left == 0){
+        return false;
+    }
+
+    // Wait for the frame period.
+    now = schedTicks();
+    if ((uint16_t)(now - shown) < period){
+        return false;
+    }
+    shown = now;
+
+    --left;
+    if (*src++ == ANIM_KEY){
+        __animKey();
+        oledWriteBuffer();
+    } else {
+        __animDelta();
+    }
+
+    // Display RAM no longer holds the last EFIS frame.
+    scrollInvalidate();
+    return true;
+}
+
+
+bool animPlaying(void){
+    return left != 0;
+}
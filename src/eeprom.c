@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////
+// File: eeprom.c
+// Header: eeprom.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "spilib.h"
+#include "eeprom.h"
+#include "spitrace.h"
+
+
+// EEPROM instructions.
+#define READ    0b00000011  // read data from memory
+#define WRITE   0b00000010  // write data to memory
+#define WRDI    0b00000100  // reset the write enable latch
+#define WREN    0b00000110  // set the write enable latch
+#define RDSR    0b00000101  // read status register
+#define WRSR    0b00000001  // write status register
+
+
+// Status register flags.
+#define WIP     0b00000001  // write in progress
+#define WEL     0b00000010  // write enable latch
+
+
+// Decorator for selection of the EEPROM's chip-select with interrupts
+// disabled.  The previous interrupt state is restored so this is safe
+// to use before interrupts are enabled.
+#define EPM(code) do { \
+        bool gie = INTCONbits.GIE; \
+        INTCONbits.GIE = 0; \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI1); \
+        EPM_SELECT(); \
+        code \
+        EPM_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI1, SPI_TRACE_EEPROM, \
+                      SPI_TRACE_EXCHANGE); \
+        INTCONbits.GIE = gie; \
+    } while (0)
+
+
+// Description:
+//      Read the EEPROM status register.
+//
+// Output (uint8_t):
+//      Status register.
+//
+static uint8_t eepromStatus(void){
+
+    uint8_t status;
+
+    EPM(
+        spi1ExchangeByte(RDSR);
+        status = spi1ExchangeByte(0);
+    );
+
+    return status;
+}
+
+
+void eepromRead(uint16_t address, uint8_t *buf, uint8_t len){
+
+    // Reads are ignored during a write cycle.
+    while (eepromBusy());
+
+    EPM(
+        spi1ExchangeByte(READ);
+        spi1ExchangeByte(address >> 8);
+        spi1ExchangeByte(address & 0xFF);
+        spi1Exchange(len, 0, buf);
+    );
+}
+
+
+void eepromWrite(uint16_t address, const uint8_t *buf, uint8_t len){
+
+    uint8_t pageLen;
+
+    while (len > 0){
+
+        // Limit write to the end of the page.
+        pageLen = EPM_PAGE_SIZE - (uint8_t)(address % EPM_PAGE_SIZE);
+        if (pageLen > len){
+            pageLen = len;
+        }
+
+        // Write the page.
+        eepromWritePage(address, buf, pageLen);
+
+        // Next page.
+        address += pageLen;
+        buf += pageLen;
+        len -= pageLen;
+    }
+
+    // Wait for the last write cycle to finish.
+    while (eepromBusy());
+}
+
+
+void eepromWritePage(uint16_t address, const uint8_t *buf, uint8_t len){
+
+    // The write enable is ignored during a write cycle.  Interrupts
+    // are enabled between polls.
+    while (eepromBusy());
+
+    // Enable writes and write the page.
+    EPM(spi1ExchangeByte(WREN););
+    EPM(
+        spi1ExchangeByte(WRITE);
+        spi1ExchangeByte(address >> 8);
+        spi1ExchangeByte(address & 0xFF);
+        spi1Exchange(len, (uint8_t *)buf, 0);
+    );
+}
+
+
+bool eepromBusy(void){
+    return (eepromStatus() & WIP) != 0;
+}
@@ -19,6 +19,7 @@
 #include "mathlib.h"
 #include "util.h"
 #include "graphics.h"
+#include "profile.h"
 #include "efis.h"
 
 
@@ -26,36 +27,450 @@
 #define CENTER_Y GL_FRAME_HEIGHT/2  // center of frame buffer - y
 #define PLANE_RADIUS 3  // radius of plane symbol
 #define PIX_PER_DEG 2   // pixels per degree of pitch
+#define ROLL_TICKS 13   // number of bank indicator tick marks
+#define ROLL_LONG_TICKS 7   // number of long tick marks (listed first)
+
+
+// Largest sine of roll drawn as zero roll with EFIS_SCROLL, the horizon
+// then moves less than half a pixel at the edges of the screen.
+#define LEVEL_SIN (TRIG16_ONE/128)
+
+
+// Optional layers that are drawn.
+uint8_t efisLayers = EFIS_LAYERS_ALL;
+
+
+// What the last efisDraw drew.
+struct efisFrame efisFrame;
+
+
+// Frames left to show the invalid boxes.
+static uint8_t invalidCounter = 0;
+
+
+// Pitch line end points, before rotation.
+static int16_t pitchXs[2*EFIS_PITCH_LINES], pitchYs[2*EFIS_PITCH_LINES];
+
+
+// Horizon of the last frame.  Steady attitudes reuse it whole and
+// attitudes that rotate the horizon line to the same pixels reuse the
+// clipped line and polygon.
+struct efisPolygon {
+    bool cached;                // holds a horizon
+    int16_t pitch;              // pixels, see efisFrame
+    int16_t rollSin, rollCos;   // trig functions of roll
+    int16_t xs[2], ys[2];       // rotated horizon line
+    int16_t x0, y0, x1, y1;     // clipped horizon line
+    bool outside;               // horizon line off the frame buffer
+    bool onePoint;              // horizon line is a single pixel
+    int8_t n;                   // polygon length, see efisPoints
+    int16_t xp[4], yp[4];       // polygon, in order around it
+};
+static struct efisPolygon horizon = {false};
+
+
+#ifdef EFIS_XOR_UNDO
+// Horizon and inverted overlays of the frame in the frame buffer, see
+// efisDraw_.
+struct efisUndo {
+    int16_t x0, y0, x1, y1;     // clipped horizon line
+    bool outside;               // horizon line off the frame buffer
+    bool above;                 // pitch not negative
+    int16_t pitch;              // pixels, see efisFrame
+    int16_t rollSin, rollCos;   // trig functions of roll
+    uint8_t layers;             // efisLayers
+    bool invalid;               // invalid boxes drawn
+};
+static struct efisUndo undo;
+static bool undoable = false;   // frame buffer holds the last frame
+#endif
+
+
+// Bank indicator tick marks at zero roll, inner point followed by outer
+// point.  The long ticks at 0, 30, 60 and 90 degrees (and their
+// inverses) go from a radius of CENTER_Y-10 out to CENTER_Y-1 and are
+// followed by the short ticks at 10, 20 and 45 degrees (and their
+// inverses) which end at CENTER_Y-6.  They are rotated by the roll
+// angle at draw time.
+static const rom int8_t rollTickX[2*ROLL_TICKS] = {
+     22,  31,  19,  27,  11,  15,   0,   0, -11, -15, -19, -27, -22,
+    -31,  16,  18,   8,   9,   4,   5,  -4,  -5,  -8,  -9, -16, -18
+};
+static const rom int8_t rollTickY[2*ROLL_TICKS] = {
+      0,   0,  11,  16,  19,  27,  22,  31,  19,  27,  11,  16,   0,
+      0,  16,  18,  21,  24,  22,  26,  22,  26,  21,  24,  16,  18
+};
+
+
+// Description:
+//      Generate the end points of the pitch lines, before rotation, into
+//      pitchXs and pitchYs.
+//
+// Input:
+//      int16_t pitch:
+//          Pixels the horizon is drawn below the center.
+//
+//      uint8_t layers:
+//          Optional layers drawn.
+//
+// Output (uint8_t):
+//      Number of end points, two per line.
+//
+static uint8_t __efisPitchLines(int16_t pitch, uint8_t layers){
+
+    int16_t min, max;
+    uint8_t n;
+
+    max = ((pitch + 25)/10)*10;
+    min = ((pitch - 25)/10)*10;
+
+    // Generate the end points of each pitch line.
+    n = 0;
+    while (max >= min){
+
+        // Don't plot horizon again, or the 5 degree lines if they are
+        // not enabled.
+        if (max != 0 &&
+                ((layers & EFIS_LAYER_PITCH_FINE) || max % 20 == 0)){
+
+            // Figure out if tick or sub-tick.
+            if (max % 20){
+                pitchXs[n] = -10;
+                pitchXs[n+1] = +10;
+            } else {
+                pitchXs[n] = -30;
+                pitchXs[n+1] = +30;
+            }
+
+            // Set vertical location.
+            pitchYs[n] = (max - pitch);
+            pitchYs[n+1] = (max - pitch);
+            n += 2;
+        }
+
+        // Decrement pitch line by 10/PIX_PER_DEG degrees.
+        max -= 10;
+    }
+
+    return n;
+}
+
+
+// Description:
+//      Draw the pitch lines, see efisDrawPitch.
+//
+// Input:
+//      int16_t pitch:
+//          Pixels the horizon is drawn below the center.
+//
+//      int16_t rollSin:
+//          Sine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      int16_t rollCos:
+//          Cosine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      uint8_t layers:
+//          Optional layers drawn.
+//
+static void __efisDrawPitch(int16_t pitch, int16_t rollSin, int16_t rollCos,
+                            uint8_t layers){
+
+    uint8_t i, n;
+
+    // Generate the pitch lines.
+    n = __efisPitchLines(pitch, layers);
+
+    // Rotate pitch lines to be parallel with horizon and shift to
+    // center.
+    rotate16_batch(pitchXs, pitchYs, n, rollSin, rollCos,
+                   CENTER_X, CENTER_Y);
+
+    // Draw the pitch lines.
+    for (i = 0; i < n; i += 2){
+        glLine(pitchXs[i], pitchYs[i], pitchXs[i+1], pitchYs[i+1],
+               GL_COLOR_INVERT);
+    }
+}
+
+
+// Description:
+//      Draw the bank indicator tick marks, see efisDrawRoll.
+//
+// Input:
+//      int16_t rollSin:
+//          Sine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      int16_t rollCos:
+//          Cosine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      uint8_t layers:
+//          Optional layers drawn.
+//
+static void __efisDrawTicks(int16_t rollSin, int16_t rollCos, uint8_t layers){
+
+    static int16_t xs[2*ROLL_TICKS], ys[2*ROLL_TICKS];
+    uint8_t i, n;
+
+    // Number of tick mark points, the short ticks are optional.
+    if (layers & EFIS_LAYER_ROLL_FINE){
+        n = 2*ROLL_TICKS;
+    } else {
+        n = 2*ROLL_LONG_TICKS;
+    }
+
+    // Load tick marks at zero roll.
+    for (i = 0; i < n; ++i){
+        xs[i] = rollTickX[i];
+        ys[i] = rollTickY[i];
+    }
+
+    // Rotate all tick marks by the roll angle and shift to center.
+    // This is the angle sum of each tick angle and the roll angle, so
+    // only the trig functions of roll are needed.
+    rotate16_batch(xs, ys, n, rollSin, rollCos, CENTER_X, CENTER_Y);
+
+    // Plot each tick mark.
+    for (i = 0; i < n; i += 2){
+        glLine(xs[i], ys[i], xs[i+1], ys[i+1], GL_COLOR_INVERT);
+    }
+}
+
+
+// Description:
+//      Compute the horizon line and polygon into horizon, unless they
+//      are cached.
+//
+// Input:
+//      int16_t pitch:
+//          Pixels the horizon is drawn below the center.
+//
+//      int16_t rollSin:
+//          Sine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      int16_t rollCos:
+//          Cosine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+static void __efisPolygon(int16_t pitch, int16_t rollSin, int16_t rollCos){
+
+    int16_t xs[2], ys[2];
+    uint8_t xa[4], ya[4];
+    uint8_t i, n;
+    bool swap;
+
+    // Same attitude.
+    if (horizon.cached && pitch == horizon.pitch &&
+            rollSin == horizon.rollSin && rollCos == horizon.rollCos){
+        return;
+    }
+    horizon.pitch = pitch;
+    horizon.rollSin = rollSin;
+    horizon.rollCos = rollCos;
+
+    // Rotate the horizon line, see efisHorizon.
+    xs[0] = -128;
+    xs[1] =  128;
+    ys[0] = -pitch;
+    ys[1] = ys[0];
+    rotate16_batch(xs, ys, 2, rollSin, rollCos, CENTER_X, CENTER_Y);
+
+    // Same horizon line.
+    if (horizon.cached &&
+            xs[0] == horizon.xs[0] && ys[0] == horizon.ys[0] &&
+            xs[1] == horizon.xs[1] && ys[1] == horizon.ys[1]){
+        return;
+    }
+    horizon.xs[0] = xs[0];
+    horizon.ys[0] = ys[0];
+    horizon.xs[1] = xs[1];
+    horizon.ys[1] = ys[1];
+    horizon.cached = true;
+
+    // Clip it and find the polygon.
+    horizon.x0 = xs[0];
+    horizon.y0 = ys[0];
+    horizon.x1 = xs[1];
+    horizon.y1 = ys[1];
+    horizon.outside = glClipLine(&horizon.x0, &horizon.y0,
+                                 &horizon.x1, &horizon.y1);
+    horizon.onePoint = horizon.x0 == horizon.x1 &&
+                       horizon.y0 == horizon.y1;
+    if (horizon.outside || horizon.onePoint){
+        return;
+    }
+    horizon.n = efisPoints(xa, ya, horizon.x0, horizon.y0,
+                           horizon.x1, horizon.y1);
+
+    // Put the polygon in order for glPolygonFill.  Both corners of a 4
+    // point polygon are on one side of the frame buffer and the one
+    // after the horizon line is the one nearer its end, which is the
+    // lower corner if the end is in the lower half along that side.
+    n = horizon.n < 0 ? -horizon.n : horizon.n;
+    for (i = 0; i < n; ++i){
+        horizon.xp[i] = xa[i];
+        horizon.yp[i] = ya[i];
+    }
+    if (n == 4){
+        if (xa[2] == xa[3]){
+            swap = (ya[2] < ya[3]) == (2*horizon.y1 > GL_MAX_Y);
+        } else {
+            swap = (xa[2] < xa[3]) == (2*horizon.x1 > GL_MAX_X);
+        }
+        if (swap){
+            horizon.xp[2] = xa[3];
+            horizon.yp[2] = ya[3];
+            horizon.xp[3] = xa[2];
+            horizon.yp[3] = ya[2];
+        }
+    }
+}
+
+
+// Description:
+//      Draw the invalid boxes, crossed out if EFIS_LAYER_INVALID_CROSS is
+//      set in <layers>.
+//
+// Input:
+//      uint8_t layers:
+//          Optional layers drawn.
+//
+static void __efisInvalidBoxes(uint8_t layers){
+
+    // Left and right side warning blocks.
+    glRectFill(5, 5, 25, GL_MAX_Y-5, GL_COLOR_INVERT);
+    glRectFill(GL_MAX_X-25, 5, GL_MAX_X-5, GL_MAX_Y-5, GL_COLOR_INVERT);
+
+    // Crosses through the warning blocks.
+    if (layers & EFIS_LAYER_INVALID_CROSS){
+        glLine(5, 5, 25, GL_MAX_Y-5, GL_COLOR_INVERT);
+        glLine(25, 5, 5, GL_MAX_Y-5, GL_COLOR_INVERT);
+        glLine(GL_MAX_X-25, 5, GL_MAX_X-5, GL_MAX_Y-5, GL_COLOR_INVERT);
+        glLine(GL_MAX_X-5, 5, GL_MAX_X-25, GL_MAX_Y-5, GL_COLOR_INVERT);
+    }
+}
+
+
+#ifdef EFIS_XOR_UNDO
+// Description:
+//      Change the inverted overlays of the last frame to those of this
+//      one by drawing the old ones again, which erases them, and then
+//      the new ones.  The plane symbol and bank pointer do not move and
+//      are left.  Overlays erased over the compass leave it garbled,
+//      it is drawn again after.
+//
+// Input:
+//      int16_t rollSin:
+//          Sine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+//      int16_t rollCos:
+//          Cosine of roll angle.  Scaled from zero to TRIG16_ONE.
+//
+static void __efisRedrawOverlays(int16_t rollSin, int16_t rollCos){
+
+    bool rolled;
+
+    // Erase the invalid boxes, efisDrawInvalid draws them again.
+    if (undo.invalid){
+        __efisInvalidBoxes(undo.layers);
+    }
+
+    rolled = rollSin != undo.rollSin || rollCos != undo.rollCos;
+
+    PROFILE_BEGIN(PROFILE_PITCH);
+    if (rolled || efisFrame.pitch != undo.pitch ||
+            ((efisLayers ^ undo.layers) & EFIS_LAYER_PITCH_FINE)){
+        __efisDrawPitch(undo.pitch, undo.rollSin, undo.rollCos,
+                        undo.layers);
+        __efisDrawPitch(efisFrame.pitch, rollSin, rollCos, efisLayers);
+    }
+    PROFILE_END(PROFILE_PITCH);
+
+    PROFILE_BEGIN(PROFILE_ROLL);
+    if (rolled || ((efisLayers ^ undo.layers) & EFIS_LAYER_ROLL_FINE)){
+        __efisDrawTicks(undo.rollSin, undo.rollCos, undo.layers);
+        __efisDrawTicks(rollSin, rollCos, efisLayers);
+    }
+    PROFILE_END(PROFILE_ROLL);
+}
+#endif
 
 
 void efisDraw(int16_t yaw, int16_t pitch, int16_t roll, bool valid){
-    efisDrawAI(pitch, roll);
+    efisDraw_(yaw, pitch, sin16(roll), cos16(roll), valid);
+}
+
+
+void efisDraw_(int16_t yaw, int16_t pitch,
+               int16_t rollSin, int16_t rollCos, bool valid){
+#ifdef EFIS_XOR_UNDO
+    bool above;
+#endif
+
+#ifdef EFIS_SCROLL
+    // Draw nearly wings level frames level so they can be scrolled.
+    if (rollCos > 0 && rollSin >= -LEVEL_SIN && rollSin <= LEVEL_SIN){
+        rollSin = 0;
+        rollCos = TRIG16_ONE;
+    }
+#endif
+    efisFrame.pitch = toDeg(pitch*PIX_PER_DEG);
+    efisFrame.layers = efisLayers;
+    efisFrame.level = rollSin == 0 && rollCos > 0;
+
+#ifdef EFIS_XOR_UNDO
+    // Keep the horizon if it is drawn the same and only change the
+    // inverted overlays on top of it.
+    __efisPolygon(efisFrame.pitch, rollSin, rollCos);
+    above = pitch >= 0;
+    if (undoable && horizon.outside == undo.outside && above == undo.above &&
+            horizon.x0 == undo.x0 && horizon.y0 == undo.y0 &&
+            horizon.x1 == undo.x1 && horizon.y1 == undo.y1){
+        __efisRedrawOverlays(rollSin, rollCos);
+    } else {
+        efisDrawAI_(pitch, rollSin, rollCos);
+    }
+    undo.x0 = horizon.x0;
+    undo.y0 = horizon.y0;
+    undo.x1 = horizon.x1;
+    undo.y1 = horizon.y1;
+    undo.outside = horizon.outside;
+    undo.above = above;
+    undo.pitch = efisFrame.pitch;
+    undo.rollSin = rollSin;
+    undo.rollCos = rollCos;
+    undo.layers = efisLayers;
+#else
+    efisDrawAI_(pitch, rollSin, rollCos);
+#endif
+
+    PROFILE_BEGIN(PROFILE_COMPASS);
     efisDrawCompass(yaw);
+    PROFILE_END(PROFILE_COMPASS);
     efisDrawInvalid(valid);
+
+#ifdef EFIS_XOR_UNDO
+    undo.invalid = efisFrame.invalid;
+    undoable = true;
+#endif
 }
 
 
-void efisDrawInvalid(bool valid){
+void efisInvalidate(void){
+#ifdef EFIS_XOR_UNDO
+    undoable = false;
+#endif
+}
 
-    static uint8_t invalidCounter = 0;
+
+void efisDrawInvalid(bool valid){
 
     // If data not valid start invalid counter (15 frames).
     if (!valid){
         invalidCounter = 15;
     }
+    efisFrame.invalid = invalidCounter > 0;
 
     if (invalidCounter > 0){
-
-        // Left side warning block.
-        glRectFill(5, 5, 25, GL_MAX_Y-5, GL_COLOR_INVERT);
-        glLine(5, 5, 25, GL_MAX_Y-5, GL_COLOR_INVERT);
-        glLine(25, 5, 5, GL_MAX_Y-5, GL_COLOR_INVERT);
-
-        // Right side warning block.
-        glRectFill(GL_MAX_X-25, 5, GL_MAX_X-5, GL_MAX_Y-5, GL_COLOR_INVERT);
-        glLine(GL_MAX_X-25, 5, GL_MAX_X-5, GL_MAX_Y-5, GL_COLOR_INVERT);
-        glLine(GL_MAX_X-5, 5, GL_MAX_X-25, GL_MAX_Y-5, GL_COLOR_INVERT);
-
+        __efisInvalidBoxes(efisLayers);
         --invalidCounter;
     }
 }
@@ -73,6 +488,7 @@ void efisDrawCompass(int16_t yaw){
     while (yaw > 360){
         yaw -= 360;
     }
+    efisFrame.heading = yaw;
 
     // Print yaw angle (heading) to buffer.
     sprintf(buffer, STR("%03d"), yaw);
@@ -88,15 +504,21 @@ void efisDrawCompass(int16_t yaw){
 
 
 void efisDrawAI(int16_t pitch, int16_t roll){
+    efisDrawAI_(pitch, sin16(roll), cos16(roll));
+}
 
-    int16_t rollSin, rollCos;
-    rollSin = sin16(roll);
-    rollCos = cos16(roll);
 
+void efisDrawAI_(int16_t pitch, int16_t rollSin, int16_t rollCos){
+    PROFILE_BEGIN(PROFILE_HORIZON);
     efisDrawHorizon(pitch, rollSin, rollCos);
+    PROFILE_END(PROFILE_HORIZON);
     efisDrawPlane();
+    PROFILE_BEGIN(PROFILE_PITCH);
     efisDrawPitch(pitch, rollSin, rollCos);
-    efisDrawRoll(roll);
+    PROFILE_END(PROFILE_PITCH);
+    PROFILE_BEGIN(PROFILE_ROLL);
+    efisDrawRoll(rollSin, rollCos);
+    PROFILE_END(PROFILE_ROLL);
 }
 
 
@@ -117,55 +539,73 @@ void efisDrawPlane(){
 
 
 void efisDrawPitch(int16_t pitch, int16_t rollSin, int16_t rollCos){
+    __efisDrawPitch(toDeg(pitch*PIX_PER_DEG), rollSin, rollCos, efisLayers);
+}
 
-    int16_t min, max;
-    int16_t x0, y0, x1, y1;
-
-    // Prepare degrees.
-    pitch = toDeg(pitch*PIX_PER_DEG);
-    max = ((pitch + 25)/10)*10;
-    min = ((pitch - 25)/10)*10;
-
-    // Loop through each pitch line.
-    while (max >= min){
 
-        // Don't plot horizon again.
-        if (max != 0){
+uint8_t efisPitchLines(int16_t pitch, uint8_t layers,
+                       struct efisBox boxes[EFIS_PITCH_LINES]){
 
-            // Figure out if tick or sub-tick.
-            if (max % 20){
-                x0 = -10;
-                x1 = +10;
-            } else {
-                x0 = -30;
-                x1 = +30;
-            }
+    uint8_t i, n;
 
-            // Set vertical location.
-            y0 = (max - pitch);
-            y1 = (max - pitch);
+    // At zero roll the lines are only shifted to the center.
+    n = __efisPitchLines(pitch, layers);
+    for (i = 0; i < n; i += 2){
+        boxes->x0 = CENTER_X + pitchXs[i];
+        boxes->x1 = CENTER_X + pitchXs[i+1];
+        boxes->y0 = CENTER_Y + pitchYs[i];
+        boxes->y1 = boxes->y0;
+        ++boxes;
+    }
 
-            // Rotate pitch line to be parallel with horizon.
-            rotate16_(&x0, &y0, rollSin, rollCos);
-            rotate16_(&x1, &y1, rollSin, rollCos);
+    return n/2;
+}
 
-            // Shift to center.
-            x0 += CENTER_X;
-            x1 += CENTER_X;
-            y0 += CENTER_Y;
-            y1 += CENTER_Y;
 
-            // Draw the pitch line.
-            glLine(x0, y0, x1, y1, GL_COLOR_INVERT);
+void efisOverlays(struct efisBox boxes[EFIS_OVERLAYS]){
+
+    uint8_t i;
+    int8_t x0, x1;
+
+    // Compass, see efisDrawCompass.
+    boxes->x0 = CENTER_X-GL_CHAR_WIDTH-2;
+    boxes->x1 = CENTER_X+2*GL_CHAR_WIDTH+2;
+    boxes->y0 = 0;
+    boxes->y1 = GL_CHAR_HEIGHT+2;
+    ++boxes;
+
+    // Plane symbol, see efisDrawPlane.
+    boxes->x0 = CENTER_X-PLANE_RADIUS-1-5;
+    boxes->x1 = CENTER_X+PLANE_RADIUS+1+5;
+    boxes->y0 = CENTER_Y-PLANE_RADIUS;
+    boxes->y1 = CENTER_Y+PLANE_RADIUS+1+5;
+    ++boxes;
+
+    // Bank pointer, see efisDrawRoll.
+    boxes->x0 = CENTER_X-3;
+    boxes->x1 = CENTER_X+3;
+    boxes->y0 = CENTER_Y+16;
+    boxes->y1 = CENTER_Y+20;
+    ++boxes;
+
+    // Bank ticks at zero roll, the inner point is nearer the center.
+    for (i = 0; i < 2*ROLL_TICKS; i += 2){
+        x0 = rollTickX[i];
+        x1 = rollTickX[i+1];
+        if (x0 > x1){
+            x0 = x1;
+            x1 = rollTickX[i];
         }
-
-        // Decrement pitch line by 10/PIX_PER_DEG degrees.
-        max -= 10;
+        boxes->x0 = CENTER_X + x0;
+        boxes->x1 = CENTER_X + x1;
+        boxes->y0 = CENTER_Y + rollTickY[i];
+        boxes->y1 = CENTER_Y + rollTickY[i+1];
+        ++boxes;
     }
 }
 
 
-void efisDrawRoll(int16_t roll){
+void efisDrawRoll(int16_t rollSin, int16_t rollCos){
 
     // Draw pointing triangle.
     glTriangleFill(CENTER_X-3, CENTER_Y+16,
@@ -173,66 +613,22 @@ void efisDrawRoll(int16_t roll){
                    CENTER_X, CENTER_Y+20, 
                    GL_COLOR_INVERT);
 
-    // Draw each tick mark.
-    efisDrawRollLine(fromDeg(-90) + roll, 10);
-    efisDrawRollLine(fromDeg(-60) + roll, 10);
-    efisDrawRollLine(fromDeg(-45) + roll,  5);
-    efisDrawRollLine(fromDeg(-30) + roll, 10);
-    efisDrawRollLine(fromDeg(-20) + roll,  5);
-    efisDrawRollLine(fromDeg(-10) + roll,  5);
-    efisDrawRollLine(fromDeg(  0) + roll, 10);
-    efisDrawRollLine(fromDeg(+10) + roll,  5);
-    efisDrawRollLine(fromDeg(+20) + roll,  5);
-    efisDrawRollLine(fromDeg(+30) + roll, 10);
-    efisDrawRollLine(fromDeg(+45) + roll,  5);
-    efisDrawRollLine(fromDeg(+60) + roll, 10);
-    efisDrawRollLine(fromDeg(+90) + roll, 10);
-}
-
-
-void efisDrawRollLine(int16_t theta, uint8_t length){
-
-    int16_t x0, y0, x1, y1, s, c;
-
-    // Generate non rotated tick mark coordinates.
-    x0 = 0;
-    x1 = 0;
-    y0 = CENTER_Y - 10;
-    y1 = CENTER_Y - 10 + (int16_t)(length-1);
-
-    // Rotate the tick mark.
-    s = sin16(theta);
-    c = cos16(theta);
-    rotate16_(&x0, &y0, s, c);
-    rotate16_(&x1, &y1, s, c);
-
-    // Shift to proper location.
-    x0 += CENTER_X;
-    x1 += CENTER_X;
-    y0 += CENTER_Y;
-    y1 += CENTER_Y;
-
-    // Plot the tick mark.
-    glLine(x0, y0, x1, y1, GL_COLOR_INVERT);
+    // Draw the tick marks.
+    __efisDrawTicks(rollSin, rollCos, efisLayers);
 }
 
 
 void efisDrawHorizon(int16_t pitch, int16_t rollSin, int16_t rollCos){
 
-    bool outside, onePoint;
-    int16_t x0, y0, x1, y1;
     int8_t n;
     uint8_t color;
-    uint8_t xa[4];
-    uint8_t ya[4];
 
-    // Calculate horizon line.
-    outside = efisHorizon(pitch, rollSin, rollCos, &x0, &y0, &x1, &y1);
-    onePoint = x0 == x1 && y0 == y1;
+    // Calculate horizon line and polygon, or reuse the last ones.
+    __efisPolygon(toDeg(pitch*PIX_PER_DEG), rollSin, rollCos);
 
     // Handle special cases of a 1 pixel horizon line and no horizon
     // line.
-    if (outside || onePoint){
+    if (horizon.outside || horizon.onePoint){
         if (pitch >= 0){
             glSet();
             color = GL_COLOR_BLACK;
@@ -240,14 +636,14 @@ void efisDrawHorizon(int16_t pitch, int16_t rollSin, int16_t rollCos){
             glClear();
             color = GL_COLOR_WHITE;
         }
-        if (onePoint){
-            glPoint(x0, y0, color);
+        if (horizon.onePoint){
+            glPoint(horizon.x0, horizon.y0, color);
         }
         return;
     }
 
-    // Calculate point of drawn entities.
-    n = efisPoints(xa, ya, x0, y0, x1, y1);
+    // Polygon of drawn entities.
+    n = horizon.n;
 
     // Sky is drawn entity.
     if (n > 0){
@@ -261,18 +657,8 @@ void efisDrawHorizon(int16_t pitch, int16_t rollSin, int16_t rollCos){
         n = -n;
     }
 
-    // Handle the 3 different scenarios.
-    switch (n){
-        case 2:     // draw as a line
-            glLine(xa[0], ya[0], xa[1], ya[1], color);
-            break;
-        case 3:     // draw as a triangle
-            glTriangleFill(xa[0], ya[0], xa[1], ya[1], xa[2], ya[2], color);
-            break;
-        case 4:     // draw as a rectangle + triangle
-            efisDrawHorizonAsPolygon(xa, ya, color);
-            break;
-    }
+    // A line, triangle or quadrilateral.
+    glPolygonFill(horizon.xp, horizon.yp, n, color);
 }
 
 
@@ -282,22 +668,23 @@ bool efisHorizon(int16_t pitch, int16_t rollSin, int16_t rollCos,
                  int16_t *x0_ptr, int16_t *y0_ptr,
                  int16_t *x1_ptr, int16_t *y1_ptr){
 
+    int16_t xs[2], ys[2];
+
     // Initialize horizon line to correct pitch.
-    *x0_ptr = -128;
-    *x1_ptr =  128;
-    /* *y0_ptr = -((int32_t)pitch*360L)/16384L; */
-    *y0_ptr = -toDeg(pitch*PIX_PER_DEG);
-    *y1_ptr = *y0_ptr;
-
-    // Rotate horizon line by pitch angle.
-    rotate16_(x0_ptr, y0_ptr, rollSin, rollCos);
-    rotate16_(x1_ptr, y1_ptr, rollSin, rollCos);
-
-    // Shift horizon line into center of frame buffer.
-    *x0_ptr += GL_FRAME_WIDTH/2;
-    *x1_ptr += GL_FRAME_WIDTH/2;
-    *y0_ptr += GL_FRAME_HEIGHT/2;
-    *y1_ptr += GL_FRAME_HEIGHT/2;
+    xs[0] = -128;
+    xs[1] =  128;
+    /* ys[0] = -((int32_t)pitch*360L)/16384L; */
+    ys[0] = -toDeg(pitch*PIX_PER_DEG);
+    ys[1] = ys[0];
+
+    // Rotate horizon line by roll angle and shift it into center of
+    // frame buffer.
+    rotate16_batch(xs, ys, 2, rollSin, rollCos,
+                   GL_FRAME_WIDTH/2, GL_FRAME_HEIGHT/2);
+    *x0_ptr = xs[0];
+    *y0_ptr = ys[0];
+    *x1_ptr = xs[1];
+    *y1_ptr = ys[1];
 
     // Clip horizon line to frame buffer.
     return glClipLine(x0_ptr, y0_ptr, x1_ptr, y1_ptr);
@@ -380,54 +767,3 @@ int8_t efisPoints(uint8_t xa[], uint8_t ya[],
         return -n;
     }
 }
-
-
-void efisDrawHorizonAsPolygon(uint8_t xa[4], uint8_t ya[4], uint8_t color){
-
-    uint8_t peak;
-
-    // Horizontal case.
-    if (xa[2] == xa[3]){
-
-        // Drawing left side of frame buffer.
-        if (xa[2] == GL_MIN_X){
-            // Get index of triangle point.
-            peak = (xa[0] > xa[1]) ? 0 : 1;
-            // Draw rectangle.
-            glRectFill_(GL_MIN_X, GL_MIN_Y, xa[!peak], GL_MAX_Y, color);
-
-        // Drawing right side of frame buffer.
-        } else {
-            // Get index of triangle point.
-            peak = (xa[0] < xa[1]) ? 0 : 1;
-            // Draw rectangle.
-            glRectFill_(xa[!peak], 0, GL_MAX_X, GL_MAX_Y, color);
-        }
-
-        // Draw triangle.
-        glTriangleFillFVS(xa[!peak], GL_MIN_Y, GL_MAX_Y,
-                          xa[peak], ya[peak], color);
-
-    // Vertical case.
-    } else { // ya[0] == ya[1]
-
-        // Drawing bottom of frame buffer.
-        if (ya[2] == GL_MIN_Y){
-            // Get index of triangle point.
-            peak = (ya[0] > ya[1]) ? 0 : 1;
-            // Draw rectangle.
-            glRectFill_(GL_MIN_X, GL_MIN_Y, GL_MAX_X, ya[!peak], color);
-
-        // Drawing top of frame buffer.
-        } else {
-            // Get index of triangle point.
-            peak = (ya[0] < ya[1]) ? 0 : 1;
-            // Draw rectangle.
-            glRectFill_(GL_MIN_X, ya[!peak], GL_MAX_X, GL_MAX_Y, color);
-        }
-
-        // Draw triangle.
-        glTriangleFillFVS(xa[peak], ya[peak], ya[!peak],
-                          xa[!peak], ya[!peak], color);
-    }
-}
@@ -25,10 +25,44 @@
 #define bitNumber(y, byte) ((8-byte)*8 - (y + 1))
 
 
+// Combine the bits of an 8 pixel column byte into the frame buffer,
+// only bits set in mask are touched.
+#define GL_BLEND(dst, bits, mask, color)                                \
+    switch (color){                                                     \
+        case GL_COLOR_WHITE: (dst) |= (bits); break;                    \
+        case GL_COLOR_BLACK: (dst) &= ~(bits); break;                   \
+        case GL_COLOR_INVERT: (dst) ^= (bits); break;                   \
+        case GL_COLOR_OVERWRITE: (dst) = ((dst) & ~(mask)) | (bits);    \
+            break;                                                      \
+    }
+
+
 // Extern the frame buffer.
 extern uint8_t frameBuffer[GL_FRAME_SIZE];
 
 
+// Bit of a pixel in its frame buffer byte, by vertical coordinate modulo
+// 8.
+static const rom uint8_t pixelBit[8] = {
+    0b10000000, 0b01000000, 0b00100000, 0b00010000,
+    0b00001000, 0b00000100, 0b00000010, 0b00000001
+};
+
+
+// Bits of a vertical line in the byte it starts in, by bit number.
+static const rom uint8_t startBrushes[8] = {
+    0b11111111, 0b11111110, 0b11111100, 0b11111000,
+    0b11110000, 0b11100000, 0b11000000, 0b10000000
+};
+
+
+// Bits of a vertical line in the byte it ends in, by bit number.
+static const rom uint8_t endBrushes[8] = {
+    0b00000001, 0b00000011, 0b00000111, 0b00001111,
+    0b00011111, 0b00111111, 0b01111111, 0b11111111
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // ASCII 6x8 Font Character Array
 //
@@ -203,29 +237,9 @@ void glVLine_(uint8_t x, uint8_t y0, uint8_t y1, uint8_t color){
     endByte   = byteNumber(y0);
     endBit    = bitNumber(y0, endByte);
 
-    // Find start brush.
-    switch (startBit){
-        case 0: startBrush = 0b11111111; break;
-        case 1: startBrush = 0b11111110; break;
-        case 2: startBrush = 0b11111100; break;
-        case 3: startBrush = 0b11111000; break;
-        case 4: startBrush = 0b11110000; break;
-        case 5: startBrush = 0b11100000; break;
-        case 6: startBrush = 0b11000000; break;
-        case 7: startBrush = 0b10000000; break;
-    }
-
-    // Find end brush.
-    switch (endBit){
-        case 0: endBrush = 0b00000001; break;
-        case 1: endBrush = 0b00000011; break;
-        case 2: endBrush = 0b00000111; break;
-        case 3: endBrush = 0b00001111; break;
-        case 4: endBrush = 0b00011111; break;
-        case 5: endBrush = 0b00111111; break;
-        case 6: endBrush = 0b01111111; break;
-        case 7: endBrush = 0b11111111; break;
-    }
+    // Find start and end brushes.
+    startBrush = startBrushes[startBit];
+    endBrush = endBrushes[endBit];
 
     // Calculate starting byte index.
     idx = (uint16_t)startByte + (uint16_t)x*(GL_FRAME_HEIGHT/8);
@@ -504,7 +518,7 @@ uint8_t glClipCode(int16_t x, int16_t y){
     }
 
     // Point is on right.
-    if (x > GL_FRAME_WIDTH){
+    if (x > GL_FRAME_WIDTH-1){
         clipCode |= GL_CCR;
     }
 
@@ -608,29 +622,9 @@ void glRectFill_(
     endByte   = byteNumber(y0);
     endBit    = bitNumber(y0, endByte);
 
-    // Find start brush.
-    switch (startBit){
-        case 0: startBrush = 0b11111111; break;
-        case 1: startBrush = 0b11111110; break;
-        case 2: startBrush = 0b11111100; break;
-        case 3: startBrush = 0b11111000; break;
-        case 4: startBrush = 0b11110000; break;
-        case 5: startBrush = 0b11100000; break;
-        case 6: startBrush = 0b11000000; break;
-        case 7: startBrush = 0b10000000; break;
-    }
-
-    // Find end brush.
-    switch (endBit){
-        case 0: endBrush = 0b00000001; break;
-        case 1: endBrush = 0b00000011; break;
-        case 2: endBrush = 0b00000111; break;
-        case 3: endBrush = 0b00001111; break;
-        case 4: endBrush = 0b00011111; break;
-        case 5: endBrush = 0b00111111; break;
-        case 6: endBrush = 0b01111111; break;
-        case 7: endBrush = 0b11111111; break;
-    }
+    // Find start and end brushes.
+    startBrush = startBrushes[startBit];
+    endBrush = endBrushes[endBit];
 
     // Calculate starting byte index.
     startIdx = (uint16_t)startByte + (uint16_t)x0*(GL_FRAME_HEIGHT/8);
@@ -718,12 +712,91 @@ void glRectFill_(
 }
 
 
+// Description:
+//      Draw a pixel that is known to be on the frame buffer.
+//
+// Input:
+//      uint8_t x:
+//          Horizontal coordinate.
+//
+//      uint8_t y:
+//          Vertical coordinate.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+static void __glPixel(uint8_t x, uint8_t y, uint8_t color){
+
+    uint16_t idx;
+
+    idx = (uint16_t)x*(GL_FRAME_HEIGHT/8) + byteNumber(y);
+    GL_BLEND(frameBuffer[idx], pixelBit[y & 7], 0, color);
+}
+
+
+// Description:
+//      Draw the pixel of an ellipse in each quadrant, pixels on an axis
+//      only once.
+//
+// Input:
+//      int16_t xc:
+//          Horizontal coordinate of center.
+//
+//      int16_t yc:
+//          Vertical coordinate of center.
+//
+//      int16_t x:
+//          Horizontal offset from the center, zero or negative.
+//
+//      int16_t y:
+//          Vertical offset from the center, zero or positive.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+//      bool clip:
+//          The ellipse is not entirely on the frame buffer.
+//
+static void __glEllipsePoints(int16_t xc, int16_t yc, int16_t x, int16_t y,
+                              uint8_t color, bool clip){
+
+    if (clip){
+        glPoint(xc+x, yc+y, color);
+        if (y != 0){
+            glPoint(xc+x, yc-y, color);
+        }
+        if (x != 0){
+            glPoint(xc-x, yc+y, color);
+            if (y != 0){
+                glPoint(xc-x, yc-y, color);
+            }
+        }
+    } else {
+        __glPixel(xc+x, yc+y, color);
+        if (y != 0){
+            __glPixel(xc+x, yc-y, color);
+        }
+        if (x != 0){
+            __glPixel(xc-x, yc+y, color);
+            if (y != 0){
+                __glPixel(xc-x, yc-y, color);
+            }
+        }
+    }
+}
+
+
 // Bresenham algorithm for Ellipses from:
 // http://members.chello.at/~easyfilter/bresenham.html
 void glEllipse(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr, uint8_t color){
 
     int16_t x, y;
     int32_t dx, dy, e2, err, a2, b2;
+    bool clip;
+
+    // Decide once if the pixels need clipping.
+    clip = xc < xr || xc + xr >= GL_FRAME_WIDTH ||
+           yc < yr || yc + yr >= GL_FRAME_HEIGHT;
 
     // Precomputed constants.
     a2 = 2*(int32_t)xr*(int32_t)xr;
@@ -744,18 +817,7 @@ void glEllipse(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr, uint8_t color){
     // Draw ellipse.
     do {
         // Draw pixel in each quadrant.
-        if (y == 0){
-            glPoint(xc+x, yc+y, color);
-            glPoint(xc-x, yc+y, color);
-        } else if (x == 0){
-            glPoint(xc+x, yc+y, color);
-            glPoint(xc+x, yc-y, color);
-        } else {
-            glPoint(xc+x, yc+y, color);
-            glPoint(xc+x, yc-y, color);
-            glPoint(xc-x, yc-y, color);
-            glPoint(xc-x, yc+y, color);
-        }
+        __glEllipsePoints(xc, yc, x, y, color, clip);
 
         // Update pixel coordinate.
         e2 = 2*err;
@@ -771,8 +833,7 @@ void glEllipse(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr, uint8_t color){
 
     // Finish ellipse where xr == 1;
     while (y++ < (int16_t)yr){
-        glPoint(xc, yc+y, color);
-        glPoint(xc, yc-y, color);
+        __glEllipsePoints(xc, yc, 0, y, color, clip);
     }
 }
 
@@ -782,6 +843,100 @@ void glCircle(int16_t xc, int16_t yc, uint8_t r, uint8_t color){
 }
 
 
+// Description:
+//      Draw the columns of a filled ellipse at a horizontal offset from
+//      the center.
+//
+// Input:
+//      int16_t xc:
+//          Horizontal coordinate of center.
+//
+//      int16_t yc:
+//          Vertical coordinate of center.
+//
+//      int16_t x:
+//          Horizontal offset from the center, zero or negative.
+//
+//      int16_t y:
+//          Half height of the columns.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+//      bool clip:
+//          The ellipse is not entirely on the frame buffer.
+//
+static void __glEllipseSpans(int16_t xc, int16_t yc, int16_t x, int16_t y,
+                             uint8_t color, bool clip){
+
+    if (clip){
+        glVLine(xc+x, yc-y, yc+y, color);
+        if (x != 0){
+            glVLine(xc-x, yc-y, yc+y, color);
+        }
+    } else {
+        glVLine_(xc+x, yc-y, yc+y, color);
+        if (x != 0){
+            glVLine_(xc-x, yc-y, yc+y, color);
+        }
+    }
+}
+
+
+// Same Bresenham algorithm as glEllipse, the pixels of a column are the
+// ones between the last pixel drawn in it and its mirror image.
+void glEllipseFill(int16_t xc, int16_t yc, uint8_t xr, uint8_t yr,
+                   uint8_t color){
+
+    int16_t x, y;
+    int32_t dx, dy, e2, err, a2, b2;
+    bool clip;
+
+    // Decide once if the columns need clipping.
+    clip = xc < xr || xc + xr >= GL_FRAME_WIDTH ||
+           yc < yr || yc + yr >= GL_FRAME_HEIGHT;
+
+    // Precomputed constants.
+    a2 = 2*(int32_t)xr*(int32_t)xr;
+    b2 = 2*(int32_t)yr*(int32_t)yr;
+
+    // Quadrant 2.
+    x = -(int16_t)xr;
+    y = 0;
+    e2 = yr;
+
+    // Error increments.
+    dx = (1 + 2*x) * e2*e2;
+    dy = x*x;
+
+    // Error of first step.
+    err = dx + dy;
+
+    // Draw a column pair each time x steps, the center column is drawn
+    // last as glEllipse finishes it up to yr.
+    do {
+        e2 = 2*err;
+        if (e2 >= dx){
+            if (x < 0){
+                __glEllipseSpans(xc, yc, x, y, color, clip);
+            }
+            x++;
+            err += dx += b2;
+        }
+        if (e2 <= dy){
+            y++;
+            err += dy += a2;
+        }
+    } while (x <= 0);
+    __glEllipseSpans(xc, yc, 0, yr, color, clip);
+}
+
+
+void glCircleFill(int16_t xc, int16_t yc, uint8_t r, uint8_t color){
+    glEllipseFill(xc, yc, r, r, color);
+}
+
+
 void glTriangle(int16_t x0, int16_t y0,
                 int16_t x1, int16_t y1,
                 int16_t x2, int16_t y2,
@@ -807,47 +962,16 @@ void glTriangleFill(int16_t x0, int16_t y0,
                     int16_t x2, int16_t y2,
                     uint8_t color){
 
-    // Shortcut trivial cases.
-    // NOTE: This is needed because the glTriangleFill function is not
-    //       defined for the case where a side of the triangle is
-    //       vertical.
-    if (x0 == x1){
-        glTriangleFillFVS(x0, y0, y1, x2, y2, color);
-        return;
-    }
-    if (x0 == x2){
-        glTriangleFillFVS(x0, y0, y2, x1, y1, color);
-        return;
-    }
-    if (x1 == x2){
-        glTriangleFillFVS(x1, y1, y2, x0, y0, color);
-        return;
-    }
+    int16_t xs[3], ys[3];
 
-    // Rearrange points and call low level triangle fill function.
-    if (x1 <= x2){
-        if (x0 <= x1){
-            // x1 is middle
-            glTriangleFill_(x0, y0, x2, y2, x1, y1, color);
-        } else if (x0 >= x2){
-            // x2 is middle
-            glTriangleFill_(x0, y0, x1, y1, x2, y2, color);
-        } else {
-            // x0 is middle
-            glTriangleFill_(x1, y1, x2, y2, x0, y0, color);
-        }
-    } else { // x1 > x2
-        if (x0 <= x2){
-            // x2 is middle
-            glTriangleFill_(x0, y0, x1, y1, x2, y2, color);
-        } else if (x0 >= x1){
-            // x1 is middle
-            glTriangleFill_(x0, y0, x2, y2, x1, y1, color);
-        } else {
-            // x0 is middle
-            glTriangleFill_(x1, y1, x2, y2, x0, y0, color);
-        }
-    }
+    // Any order of three points goes around the triangle.
+    xs[0] = x0;
+    ys[0] = y0;
+    xs[1] = x1;
+    ys[1] = y1;
+    xs[2] = x2;
+    ys[2] = y2;
+    glPolygonFill(xs, ys, 3, color);
 }
 
 
@@ -966,6 +1090,316 @@ void glTriangleFillFVS(int16_t xs, int16_t ys0, int16_t ys1,
 }
 
 
+// Bresenham walker along one side of a convex polygon, from its
+// leftmost to its rightmost vertex, see glPolygonFill.
+struct glEdge {
+    const int16_t *xs, *ys; // polygon
+    uint8_t n;              // number of vertices
+    uint8_t i;              // vertex at the end of the current edge
+    uint8_t end;            // vertex at the end of the side
+    bool forward;           // direction around the polygon
+    int8_t out;             // vertical step away from the polygon
+    int16_t x, y;           // current pixel
+    int16_t x1, y1;         // end of the current edge
+    int16_t dx, dy, err;    // Bresenham deltas and error
+    int8_t sy;              // vertical step
+};
+
+
+// Description:
+//      Start the next edge of a walker at its current pixel.
+//
+// Input:
+//      struct glEdge *e:
+//          Walker.
+//
+static void __glEdgeNext(struct glEdge *e){
+
+    if (e->forward){
+        if (++e->i == e->n){
+            e->i = 0;
+        }
+    } else {
+        if (e->i == 0){
+            e->i = e->n;
+        }
+        --e->i;
+    }
+    e->x1 = e->xs[e->i];
+    e->y1 = e->ys[e->i];
+
+    // Going left means the polygon is not convex or out of order, end
+    // the side here instead of walking forever.
+    if (e->x1 < e->x){
+        e->end = e->i;
+        e->x1 = e->x;
+        e->y1 = e->y;
+    }
+
+    e->dx = e->x1 - e->x;
+    if (e->y < e->y1){
+        e->dy = e->y - e->y1;
+        e->sy = 1;
+    } else {
+        e->dy = e->y1 - e->y;
+        e->sy = -1;
+    }
+    e->err = e->dx + e->dy;
+}
+
+
+// Description:
+//      Walk the pixels of a side of the polygon in the current column,
+//      leaving the walker at the first pixel of the next column.
+//
+//      A side of a convex polygon first steps away from the polygon and
+//      then towards it, so its outermost pixel in a column is the last
+//      one stepped away to.
+//
+// Input:
+//      struct glEdge *e:
+//          Walker.
+//
+// Output (int16_t):
+//      Outermost pixel of the side in the column, vertically.
+//
+static int16_t __glEdgeColumn(struct glEdge *e){
+
+    int16_t e2, outer;
+
+    outer = e->y;
+
+    // Shortcut horizontal edge.
+    if (e->dy == 0 && e->x != e->x1){
+        ++e->x;
+        return outer;
+    }
+
+    // Go on to the next edge at a vertex, the side ends at the last one.
+    // The rest of an edge ending in this column is in it.
+    while (e->x == e->x1){
+        e->y = e->y1;
+        if (e->sy == e->out){
+            outer = e->y;
+        }
+        if (e->i == e->end){
+            return outer;
+        }
+        __glEdgeNext(e);
+    }
+
+    // Step within the column.
+    e2 = 2*e->err;
+    while (e2 < e->dy){
+        e->err += e->dx;
+        e->y += e->sy;
+        e2 = 2*e->err;
+    }
+    if (e->sy == e->out){
+        outer = e->y;
+    }
+
+    // Step to the next column.
+    e->err += e->dy;
+    ++e->x;
+    if (e2 <= e->dx){
+        e->err += e->dx;
+        e->y += e->sy;
+    }
+
+    return outer;
+}
+
+
+void glPolygonFill(const int16_t xs[], const int16_t ys[], uint8_t n,
+                   uint8_t color){
+
+    struct glEdge a, b;
+    uint8_t i, left, right, next, last, run;
+    int16_t x, y, first, xEnd, lo, hi, runLo, runHi, stop, e2;
+    int16_t ay, aDx, aDy, aErr, by, bDx, bDy, bErr;
+    int8_t aSy, bSy;
+    int32_t turn;
+    bool clip;
+
+    if (n == 0 || n > GL_POLYGON_MAX){
+        return;
+    }
+
+    // Find the first leftmost and last rightmost vertex and whether the
+    // polygon leaves the frame buffer vertically.
+    left = 0;
+    right = 0;
+    clip = false;
+    for (i = 0; i < n; ++i){
+        if (xs[i] < xs[left]){
+            left = i;
+        }
+        if (xs[i] >= xs[right]){
+            right = i;
+        }
+        if (ys[i] < 0 || ys[i] >= GL_FRAME_HEIGHT){
+            clip = true;
+        }
+    }
+    if (xs[left] >= GL_FRAME_WIDTH || xs[right] < 0){
+        return;
+    }
+    xEnd = xs[right] < GL_FRAME_WIDTH ? xs[right] : GL_FRAME_WIDTH - 1;
+
+    // Walk the upper and lower sides from left to right, the side going
+    // forward around the polygon is the upper one if it is clockwise.
+    next = left + 1 == n ? 0 : left + 1;
+    last = left == 0 ? n - 1 : left - 1;
+    turn = (int32_t)(xs[next] - xs[left])*(ys[last] - ys[left]) -
+           (int32_t)(ys[next] - ys[left])*(xs[last] - xs[left]);
+    a.xs = xs;
+    a.ys = ys;
+    a.n = n;
+    a.i = left;
+    a.end = right;
+    a.x = xs[left];
+    a.y = ys[left];
+    b = a;
+    a.forward = turn < 0;
+    a.out = 1;
+    b.forward = !a.forward;
+    b.out = -1;
+    __glEdgeNext(&a);
+    __glEdgeNext(&b);
+    for (x = xs[left]; x < 0; ++x){
+        __glEdgeColumn(&a);
+        __glEdgeColumn(&b);
+    }
+
+    // Fill each column between the sides, runs of columns with the same
+    // span as one rectangle.  Before the nearer end of the two current
+    // edges no vertex can be met, so up to there the edges are stepped
+    // here with their state in locals, the walkers only handle the
+    // columns with a vertex.
+    run = x;
+    runLo = 0;
+    runHi = -1;
+    ay = a.y;
+    aErr = a.err;
+    by = b.y;
+    bErr = b.err;
+    stop = x;
+    for (;; ++x){
+        first = x;
+
+        // Step both edges, as __glEdgeColumn does without vertices.  The
+        // outermost pixel of the upper side is the last one if it goes
+        // up and of the lower side if it goes down.
+        if (x < stop){
+            hi = ay;
+            if (aDy != 0){
+                e2 = 2*aErr;
+                while (e2 < aDy){
+                    aErr += aDx;
+                    ay += aSy;
+                    e2 = 2*aErr;
+                }
+                if (aSy > 0){
+                    hi = ay;
+                }
+                aErr += aDy;
+                if (e2 <= aDx){
+                    aErr += aDx;
+                    ay += aSy;
+                }
+            }
+
+            lo = by;
+            if (bDy != 0){
+                e2 = 2*bErr;
+                while (e2 < bDy){
+                    bErr += bDx;
+                    by += bSy;
+                    e2 = 2*bErr;
+                }
+                if (bSy < 0){
+                    lo = by;
+                }
+                bErr += bDy;
+                if (e2 <= bDx){
+                    bErr += bDx;
+                    by += bSy;
+                }
+            }
+
+        } else if (x > xEnd){
+            break;
+
+        // Both sides horizontal, the span holds until the nearer edge
+        // ends.
+        } else if (a.dy == 0 && b.dy == 0 && a.x != a.x1 && b.x != b.x1){
+            hi = a.y;
+            lo = b.y;
+            a.x = a.x1 < b.x1 ? a.x1 : b.x1;
+            b.x = a.x;
+            x = a.x - 1 < xEnd ? a.x - 1 : xEnd;
+
+        // Walk both sides through the vertex and pick up the new edges.
+        } else {
+            a.x = x;
+            a.y = ay;
+            a.err = aErr;
+            b.x = x;
+            b.y = by;
+            b.err = bErr;
+            hi = __glEdgeColumn(&a);
+            lo = __glEdgeColumn(&b);
+            ay = a.y;
+            aErr = a.err;
+            aDx = a.dx;
+            aDy = a.dy;
+            aSy = a.sy;
+            by = b.y;
+            bErr = b.err;
+            bDx = b.dx;
+            bDy = b.dy;
+            bSy = b.sy;
+            if (a.dy == 0 && b.dy == 0){
+                stop = x + 1;
+            } else {
+                stop = a.x1 < b.x1 ? a.x1 : b.x1;
+                if (stop > xEnd){
+                    stop = xEnd + 1;
+                }
+            }
+        }
+
+        // The sides of a sliver may cross.
+        if (lo > hi){
+            y = lo;
+            lo = hi;
+            hi = y;
+        }
+
+        if (clip){
+            if (lo < 0){
+                lo = 0;
+            }
+            if (hi >= GL_FRAME_HEIGHT){
+                hi = GL_FRAME_HEIGHT - 1;
+            }
+        }
+        if (lo != runLo || hi != runHi){
+            if (runLo <= runHi){
+                glRectFill_(run, runLo, first - 1, runHi, color);
+            }
+            run = first;
+            runLo = lo;
+            runHi = hi;
+        }
+    }
+    if (runLo <= runHi){
+        glRectFill_(run, runLo, xEnd, runHi, color);
+    }
+}
+
+
 void glChar(uint8_t line, uint8_t column, char ch, uint8_t color){
 
     uint8_t i;
@@ -1047,3 +1481,150 @@ void glString(uint8_t line, uint8_t column, uint8_t color, const char *str){
         ++str;
     }
 }
+
+
+// Description:
+//      Draw a bitmap in the glSprite layout, decoding run length
+//      encoded data as it goes.
+//
+// Input:
+//      int16_t x:
+//          Horizontal coordinate of the left edge.
+//
+//      int16_t y:
+//          Vertical coordinate of the top edge.
+//
+//      uint8_t width:
+//          Pixel width of the bitmap.
+//
+//      uint8_t height:
+//          Pixel height of the bitmap.
+//
+//      const rom uint8_t *data:
+//          Column major bitmap.
+//
+//      bool compressed:
+//          True if data is run length encoded.
+//
+//      uint8_t color:
+//          Color (defined only).
+//
+static void __glBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height,
+                       const rom uint8_t *data, bool compressed,
+                       uint8_t color){
+
+    uint8_t column, k, bytes, shift, bits, mask, lastMask, run, value;
+    int16_t row, page, p;
+    uint16_t base, b, m;
+    bool repeat, visible;
+
+    if (width == 0 || height == 0){
+        return;
+    }
+
+    // Bytes per column and the mask of the last one.
+    bytes = (uint8_t)(((uint16_t)height + 7)/8);
+    lastMask = height & 7 ? (1 << (height & 7)) - 1 : 0xFF;
+
+    // Page and bit of the top row, the row may be above the screen.
+    row = GL_MAX_Y - y;
+    shift = (uint8_t)row & 7;
+    page = (row - shift)/8;
+
+    run = 0;
+    repeat = false;
+    value = 0;
+    for (column = 0; column < width; ++column, ++x){
+
+        // Uncompressed columns off the screen are skipped.
+        visible = x >= 0 && x < GL_FRAME_WIDTH;
+        if (!visible && !compressed){
+            if (x >= GL_FRAME_WIDTH){
+                return;
+            }
+            data += bytes;
+            continue;
+        }
+
+        base = (uint16_t)x*(GL_FRAME_HEIGHT/8);
+        p = page;
+        for (k = 0; k < bytes; ++k, ++p){
+
+            // Next byte of the bitmap.
+            if (compressed){
+                if (run == 0){
+                    bits = *data++;
+                    run = (bits & 0x7F) + 1;
+                    repeat = (bits & 0x80) != 0;
+                    if (repeat){
+                        value = *data++;
+                    }
+                }
+                bits = repeat ? value : *data++;
+                --run;
+            } else {
+                bits = *data++;
+            }
+            if (!visible){
+                continue;
+            }
+
+            // Split the byte over two pages.
+            mask = k == bytes - 1 ? lastMask : 0xFF;
+            b = (uint16_t)(bits & mask) << shift;
+            m = (uint16_t)mask << shift;
+            if (p >= 0 && p < GL_FRAME_HEIGHT/8){
+                GL_BLEND(frameBuffer[base + p], (uint8_t)b, (uint8_t)m,
+                         color);
+            }
+            if (shift && p + 1 >= 0 && p + 1 < GL_FRAME_HEIGHT/8){
+                GL_BLEND(frameBuffer[base + p + 1], (uint8_t)(b >> 8),
+                         (uint8_t)(m >> 8), color);
+            }
+        }
+    }
+}
+
+
+void glBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height,
+              const rom uint8_t *data, uint8_t color){
+    __glBitmap(x, y, width, height, data, false, color);
+}
+
+
+void glSprite(int16_t x, int16_t y, const rom struct glSprite *sprite,
+              uint8_t color){
+    __glBitmap(x - sprite->xOffset, y + sprite->yOffset,
+               sprite->width, sprite->height, sprite->data,
+               (sprite->flags & GL_SPRITE_RLE) != 0, color);
+}
+
+
+void glText(int16_t x, int16_t y, uint8_t color,
+            const rom struct glFont *font, const char *str){
+
+    int16_t left;
+    uint8_t glyph;
+    uint16_t size;
+
+    left = x;
+    size = (uint16_t)font->width*(((uint16_t)font->height + 7)/8);
+    for (; *str; ++str){
+        if (*str == '\n'){
+            x = left;
+            y -= font->height;
+            continue;
+        }
+
+        // Replace characters outside the font with the last glyph.
+        glyph = (uint8_t)*str - font->first;
+        if ((uint8_t)*str < font->first || glyph >= font->count){
+            glyph = font->count - 1;
+        }
+        if (x < GL_FRAME_WIDTH && x + font->width > 0){
+            __glBitmap(x, y, font->width, font->height,
+                       font->data + (uint16_t)glyph*size, false, color);
+        }
+        x += font->width;
+    }
+}
@@ -13,7 +13,9 @@
 
 
 #include <p18cxxx.h>
+#include "config.h"
 #include "stdint.h"
+#include "stdbool.h"
 #include "util.h"
 #include "spilib.h"
 #include "dac.h"
@@ -21,6 +23,9 @@
 #include "sdcard.h"
 #include "pressure.h"
 #include "imu.h"
+#include "magcal.h"
+#include "recorder.h"
+#include "spitrace.h"
 
 
 // Inertial measurement unit buffers.
@@ -34,6 +39,18 @@ union bytes2 imuMagY[IMU_BUFFER_LENGTH];
 union bytes2 imuMagZ[IMU_BUFFER_LENGTH];
 
 
+// Number of samples received, stops at IMU_READY_SAMPLES.
+static uint8_t imuAccCount;
+static uint8_t imuMagCount;
+
+
+#ifdef IMU_MEDIAN_FILTER
+// Sliding median windows of each axis.
+static struct imuWindow imuAccXWindow, imuAccYWindow, imuAccZWindow;
+static struct imuWindow imuMagXWindow, imuMagYWindow, imuMagZWindow;
+#endif
+
+
 // Interrupt macros and defines.
 #define INT_PIN_INPUT() (TRISBbits.TRISB2 = 1)
 #define INT_RISING_EDGE() (INTCON2bits.INTEDG2 = 1)
@@ -46,29 +63,35 @@ union bytes2 imuMagZ[IMU_BUFFER_LENGTH];
 
 // Decorator for selection of the IMU's chip-select.
 #define IMU(code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI1); \
         IMU_SELECT(); \
         code \
         IMU_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI1, SPI_TRACE_IMU, SPI_TRACE_EXCHANGE); \
     } while (0)
 
 
 // Decorator for selection of IMU chip-select and setting up for
 // writing.
 #define IMU_READ(address, code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI1); \
         IMU_SELECT(); \
         spi1ExchangeByte(0b11000000 | (0b00111111 & address)); \
         code \
         IMU_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI1, SPI_TRACE_IMU, SPI_TRACE_READ); \
     } while (0)
 
 
 // Decorator for selection of IMU chip-select and settin up for
 // reading.
 #define IMU_WRITE(address, code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI1); \
         IMU_SELECT(); \
         spi1ExchangeByte(0b01000000 | (0b00111111 & address)); \
         code \
         IMU_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI1, SPI_TRACE_IMU, SPI_TRACE_WRITE); \
     } while (0)
 
 
@@ -300,6 +323,8 @@ void imuInit(void){
     // Initialize buffer indices.
     imuAccIdx = 0;
     imuMagIdx = 0;
+    imuAccCount = 0;
+    imuMagCount = 0;
 
     // Set all chip select pins to outputs.
     IMU_SELECT_PIN_OUTPUT();
@@ -362,14 +387,48 @@ void imuSpinup(void){
     // on a rising edge.  If the IMU interrupt pin is tripped before
     // interrupts are enabled it will be stuck.
     imuISR();
+}
 
-    // Wait for 1 second while the buffers fill up.
-    delayxs(1);
+
+bool imuReady(void){
+    return imuAccCount >= IMU_READY_SAMPLES &&
+           imuMagCount >= IMU_READY_SAMPLES;
 }
 
 
 // Change temporary data section for library interrupts.
 #pragma tmpdata imu_tmpdata
+int16_t imuMedian(struct imuWindow *win, int16_t sample){
+
+    uint8_t i;
+    int16_t old;
+
+    // Swap the new sample into the history.
+    old = win->history[win->oldest];
+    win->history[win->oldest] = sample;
+    if (++win->oldest == IMU_MEDIAN_LENGTH){
+        win->oldest = 0;
+    }
+
+    // Find the old sample in the sorted window.
+    for (i = 0; win->sorted[i] != old; ++i);
+
+    // Slide samples into the hole left by the old sample until the new
+    // sample fits.
+    while (i > 0 && win->sorted[i-1] > sample){
+        win->sorted[i] = win->sorted[i-1];
+        --i;
+    }
+    while (i < IMU_MEDIAN_LENGTH-1 && win->sorted[i+1] < sample){
+        win->sorted[i] = win->sorted[i+1];
+        ++i;
+    }
+    win->sorted[i] = sample;
+
+    return win->sorted[IMU_MEDIAN_LENGTH/2];
+}
+
+
 void imuISR(void){
 
     uint8_t byte;
@@ -381,6 +440,9 @@ void imuISR(void){
         if (++imuMagIdx == IMU_BUFFER_LENGTH){
             imuMagIdx = 0;
         }
+        if (imuMagCount < IMU_READY_SAMPLES){
+            ++imuMagCount;
+        }
         // Read magnetometer data into globals.
         IMU_READ(OUT_X_L_M, 
             imuMagX[imuMagIdx].uint8A = spi1ExchangeByte_ISRL(0);
@@ -390,6 +452,23 @@ void imuISR(void){
             imuMagZ[imuMagIdx].uint8A = spi1ExchangeByte_ISRL(0);
             imuMagZ[imuMagIdx].uint8B = spi1ExchangeByte_ISRL(0);
         );
+#ifdef RECORDER
+        // Record the raw sample.
+        recorderMag(imuMagX[imuMagIdx].int16, imuMagY[imuMagIdx].int16,
+                    imuMagZ[imuMagIdx].int16);
+#endif
+#ifdef IMU_MEDIAN_FILTER
+        // Reject outliers.
+        imuMagX[imuMagIdx].int16 =
+            imuMedian(&imuMagXWindow, imuMagX[imuMagIdx].int16);
+        imuMagY[imuMagIdx].int16 =
+            imuMedian(&imuMagYWindow, imuMagY[imuMagIdx].int16);
+        imuMagZ[imuMagIdx].int16 =
+            imuMedian(&imuMagZWindow, imuMagZ[imuMagIdx].int16);
+#endif
+        // Feed magnetometer calibration.
+        magcalSample(imuMagX[imuMagIdx].int16, imuMagY[imuMagIdx].int16,
+                     imuMagZ[imuMagIdx].int16);
     }
 
     // Check for new accelerometer data.
@@ -399,6 +478,9 @@ void imuISR(void){
         if (++imuAccIdx == IMU_BUFFER_LENGTH){
             imuAccIdx = 0;
         }
+        if (imuAccCount < IMU_READY_SAMPLES){
+            ++imuAccCount;
+        }
         // Read accelerometer data.
         IMU_READ(OUT_X_L_A, 
             imuAccX[imuAccIdx].uint8A = spi1ExchangeByte_ISRL(0);
@@ -408,6 +490,20 @@ void imuISR(void){
             imuAccZ[imuAccIdx].uint8A = spi1ExchangeByte_ISRL(0);
             imuAccZ[imuAccIdx].uint8B = spi1ExchangeByte_ISRL(0);
         );
+#ifdef RECORDER
+        // Record the raw sample.
+        recorderAcc(imuAccX[imuAccIdx].int16, imuAccY[imuAccIdx].int16,
+                    imuAccZ[imuAccIdx].int16);
+#endif
+#ifdef IMU_MEDIAN_FILTER
+        // Reject outliers.
+        imuAccX[imuAccIdx].int16 =
+            imuMedian(&imuAccXWindow, imuAccX[imuAccIdx].int16);
+        imuAccY[imuAccIdx].int16 =
+            imuMedian(&imuAccYWindow, imuAccY[imuAccIdx].int16);
+        imuAccZ[imuAccIdx].int16 =
+            imuMedian(&imuAccZWindow, imuAccZ[imuAccIdx].int16);
+#endif
     }
 
     IMU_INT_FLAG = 0;
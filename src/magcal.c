@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////
+// File: magcal.c
+// Header: magcal.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "util.h"
+#include "eeprom.h"
+#include "imu.h"
+#include "magcal.h"
+
+
+// Marks valid coefficients in the EEPROM.
+#define MAGIC 0xCA
+
+
+// Calibration coefficients, as stored in the EEPROM.
+struct magcalCoefficients {
+    uint8_t magic;
+    int16_t offset[3];  // hard iron offset in magnetometer counts
+    int16_t scale[3];   // soft iron scale, MAGCAL_ONE is one
+    uint8_t checksum;   // two's complement of the sum of all bytes
+};
+
+
+// Current coefficients.
+static struct magcalCoefficients coef = {
+    MAGIC, {0, 0, 0}, {MAGCAL_ONE, MAGCAL_ONE, MAGCAL_ONE}, 0
+};
+
+
+// Calibration state.
+static bool active = false;
+static int16_t calMin[3], calMax[3];
+static struct imuWindow calWindow[3];   // outlier rejection of each axis
+static uint8_t calFill;                 // readings left to fill them
+
+
+// Description:
+//      Compute the checksum of a set of coefficients.
+//
+// Input:
+//      struct magcalCoefficients *c:
+//          Coefficients to compute the checksum of.
+//
+// Output (uint8_t):
+//      Checksum, the two's complement of the sum of all bytes except
+//      the checksum itself.
+//
+static uint8_t magcalChecksum(struct magcalCoefficients *c){
+
+    uint8_t i, sum;
+    uint8_t *bytes = (uint8_t *)c;
+
+    sum = 0;
+    for (i = 0; i < sizeof(struct magcalCoefficients) - 1; ++i){
+        sum += bytes[i];
+    }
+
+    return -sum;
+}
+
+
+// Description:
+//      Correct one component of a magnetometer reading.
+//
+// Input:
+//      int16_t value:
+//          Uncorrected component.
+//
+//      uint8_t axis:
+//          Axis of the component, 0 to 2 for x to z.
+//
+// Output (int16_t):
+//      Corrected component, saturated to the int16_t range.  The
+//      product can not overflow, the difference is at most 65535 and
+//      the scale at most INT16_MAX.
+//
+static int16_t magcalCorrect(int16_t value, uint8_t axis){
+
+    int32_t corrected;
+
+    corrected = (((int32_t)value - coef.offset[axis])*coef.scale[axis])/
+                MAGCAL_ONE;
+    if (corrected > INT16_MAX){
+        return INT16_MAX;
+    }
+    if (corrected < INT16_MIN){
+        return INT16_MIN;
+    }
+    return (int16_t)corrected;
+}
+
+
+void magcalInit(void){
+
+    struct magcalCoefficients c;
+
+    // Only use stored coefficients if they are valid.
+    eepromRead(MAGCAL_EEPROM_ADDRESS, (uint8_t *)&c, sizeof(c));
+    if (c.magic == MAGIC && c.checksum == magcalChecksum(&c)){
+        coef = c;
+    }
+}
+
+
+void magcalStart(void){
+
+    uint8_t i;
+
+    for (i = 0; i < 3; ++i){
+        calMin[i] = INT16_MAX;
+        calMax[i] = INT16_MIN;
+    }
+    calFill = IMU_MEDIAN_LENGTH - 1;
+    active = true;
+}
+
+
+// Change temporary data section for library interrupts.
+#pragma tmpdata magcal_tmpdata
+void magcalSample(int16_t x, int16_t y, int16_t z){
+
+    if (!active){
+        return;
+    }
+
+    // Reject outliers.
+    x = imuMedian(&calWindow[0], x);
+    y = imuMedian(&calWindow[1], y);
+    z = imuMedian(&calWindow[2], z);
+
+    // Skip medians that still hold readings of an earlier calibration.
+    if (calFill > 0){
+        --calFill;
+        return;
+    }
+
+    // Track the extremes of each axis.
+    if (x < calMin[0]){
+        calMin[0] = x;
+    }
+    if (x > calMax[0]){
+        calMax[0] = x;
+    }
+    if (y < calMin[1]){
+        calMin[1] = y;
+    }
+    if (y > calMax[1]){
+        calMax[1] = y;
+    }
+    if (z < calMin[2]){
+        calMin[2] = z;
+    }
+    if (z > calMax[2]){
+        calMax[2] = z;
+    }
+}
+#pragma tmpdata
+
+
+bool magcalFinish(void){
+
+    uint8_t i;
+    int32_t radius[3], average, scale;
+    struct magcalCoefficients c;
+
+    if (!active){
+        return false;
+    }
+    active = false;
+
+    // Compute radius of each axis and check the unit was rotated enough.
+    for (i = 0; i < 3; ++i){
+        radius[i] = ((int32_t)calMax[i] - (int32_t)calMin[i])/2;
+        if (radius[i] < MAGCAL_MIN_RADIUS){
+            return false;
+        }
+    }
+    average = (radius[0] + radius[1] + radius[2])/3;
+
+    // Offset is the center of the extremes and the scale maps each axis
+    // radius onto the average radius.
+    c.magic = MAGIC;
+    for (i = 0; i < 3; ++i){
+        scale = (average*MAGCAL_ONE)/radius[i];
+        if (scale > INT16_MAX){
+            return false; // axis was not rotated through its extremes
+        }
+        c.offset[i] = ((int32_t)calMax[i] + (int32_t)calMin[i])/2;
+        c.scale[i] = scale;
+    }
+    c.checksum = magcalChecksum(&c);
+
+    // Use and save the coefficients.
+    coef = c;
+    eepromWrite(MAGCAL_EEPROM_ADDRESS, (uint8_t *)&coef, sizeof(coef));
+
+    return true;
+}
+
+
+bool magcalActive(void){
+    return active;
+}
+
+
+void magcalApply(int16_t *x_ptr, int16_t *y_ptr, int16_t *z_ptr){
+    *x_ptr = magcalCorrect(*x_ptr, 0);
+    *y_ptr = magcalCorrect(*y_ptr, 1);
+    *z_ptr = magcalCorrect(*z_ptr, 2);
+}
@@ -89,12 +89,16 @@ int16_t sin16(int16_t theta){
         theta = 0x1000 - theta;
     }
 
-    // Get indices into the lookup table.
+    // Get indices into the lookup table, 90 degrees is the last entry
+    // and has nothing to interpolate towards.
     idx = theta/128;
-
-    // Linearly interpolate table.
-    result = yIntercept(idx*128, sin16_table[idx],
-                        (idx+1)*128, sin16_table[idx+1], theta);
+    if (idx == TRIG16_TABLE_SIZE){
+        result = sin16_table[TRIG16_TABLE_SIZE];
+    } else {
+        // Linearly interpolate table.
+        result = yIntercept(idx*128, sin16_table[idx],
+                            (idx+1)*128, sin16_table[idx+1], theta);
+    }
 
     // Negate result if in quadrant 3 or 4.
     if (negative){
@@ -114,7 +118,18 @@ int16_t cos16(int16_t theta){
 
 
 int32_t tan16(int16_t theta){
-    return (int32_t)(sin16(theta) * 32768) / (int32_t)(cos16(theta));
+
+    int16_t s, c;
+
+    s = sin16(theta);
+    c = cos16(theta);
+
+    // Saturate at 90 and 270 degrees.
+    if (c == 0){
+        return s >= 0 ? INT32_MAX : -INT32_MAX;
+    }
+
+    return ((int32_t)s*TRIG16_ONE)/(int32_t)c;
 }
 
 
@@ -138,9 +153,12 @@ int16_t _atan16(int16_t yx){
     // Get indices into the lookup table.
     idx = yx/1024;
 
-    // Linearly interpolate table.
-    result = yIntercept(idx*1024, atan16_table[idx],
-                        (idx+1)*1024, atan16_table[idx+1], yx);
+    // Linearly interpolate table.  The last segment ends at 32768 which
+    // does not fit in an int16_t so the interval width is used directly
+    // instead of going through yIntercept.
+    result = atan16_table[idx] +
+        (int16_t)(((int32_t)(yx - idx*1024)*
+                   (int32_t)(atan16_table[idx+1] - atan16_table[idx]))/1024L);
 
     return result/8;
 }
@@ -186,6 +204,32 @@ int16_t atan216(int16_t y, int16_t x){
 }
 
 
+uint16_t sqrt32(uint32_t n){
+
+    uint32_t root, bit;
+
+    // Find the highest power of four that is not greater than n.
+    root = 0;
+    bit = 0x40000000UL;
+    while (bit > n){
+        bit >>= 2;
+    }
+
+    // Compute the root one bit at a time.
+    while (bit != 0){
+        if (n >= root + bit){
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)root;
+}
+
+
 void rotate16_(int16_t *xPtr, int16_t *yPtr, int16_t s, int16_t c){
 
     int32_t x, y;
@@ -200,12 +244,31 @@ void rotate16_(int16_t *xPtr, int16_t *yPtr, int16_t s, int16_t c){
 }
 
 
+void rotate16_batch(int16_t xs[], int16_t ys[], uint8_t n,
+                    int16_t s, int16_t c, int16_t cx, int16_t cy){
+
+    uint8_t i;
+    int32_t x, y;
+
+    for (i = 0; i < n; ++i){
+
+        // Store local copy.
+        x = xs[i];
+        y = ys[i];
+
+        // Rotate and translate the point.
+        xs[i] = (int16_t)((x*(int32_t)c - y*(int32_t)s + 0x4000L) >> 15) + cx;
+        ys[i] = (int16_t)((x*(int32_t)s + y*(int32_t)c + 0x4000L) >> 15) + cy;
+    }
+}
+
+
 int16_t yIntercept(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x){
 
     int32_t num, dom;
 
-    num = ((int32_t)(x - x0)) * ((int32_t)(y1 - y0));
-    dom = (int32_t)(x1 - x0);
+    num = ((int32_t)x - (int32_t)x0) * ((int32_t)y1 - (int32_t)y0);
+    dom = (int32_t)x1 - (int32_t)x0;
 
     return num/dom + y0;
 }
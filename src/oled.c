@@ -15,14 +15,21 @@
 #include <p18cxxx.h>
 #include "util.h"
 #include "stdint.h"
+#include "stdbool.h"
 #include "spilib.h"
 #include "oled.h"
+#include "spitrace.h"
 
 
 // Extern the frame buffer.
 extern uint8_t frameBuffer[OLED_SIZE];
 
 
+// Display state.
+static uint8_t startLine = 0;   // display RAM line at the top row
+static bool windowed = false;   // window is not the whole display
+
+
 // Control bits for used pins.
 #define RESET_TRIS TRISFbits.TRISF2
 #define SELECT_TRIS TRISFbits.TRISF5
@@ -40,27 +47,33 @@ extern uint8_t frameBuffer[OLED_SIZE];
 
 // Decorator for selection of the OLED display's chip-select.
 #define OLED(code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI2); \
         OLED_SELECT(); \
         code \
         OLED_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI2, SPI_TRACE_OLED, SPI_TRACE_EXCHANGE); \
     } while (0)
 
 
 // Decorator for selection of OLED chip-select and command bits.
 #define OLED_COMMAND(code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI2); \
         OLED_SELECT(); \
         OLED_SELECT_COMMAND(); \
         code \
         OLED_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI2, SPI_TRACE_OLED, SPI_TRACE_COMMAND); \
     } while (0)
 
 
 // Decorator for selection of OLED chip-select and data bits.
 #define OLED_DATA(code) do { \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI2); \
         OLED_SELECT(); \
         OLED_SELECT_DATA(); \
         code \
         OLED_DESELECT(); \
+        SPI_TRACE_END(SPI_TRACE_SPI2, SPI_TRACE_OLED, SPI_TRACE_DATA); \
     } while (0)
 
 
@@ -88,168 +101,44 @@ extern uint8_t frameBuffer[OLED_SIZE];
 //
 #define oledSendData(byte) OLED_DATA(spi2ExchangeByte(byte);)
 
-////////////////////////////////////////////////////////////////////////
-// NOTE: Below are some low level OLED commands, see Table 9-1 of the
-//       SSD1306 OLED controller datasheet for details.
-////////////////////////////////////////////////////////////////////////
-
-////////////////////////////////////////////////////////////////////////
-// Fundamental OLED Commands (low level)
-////////////////////////////////////////////////////////////////////////
-
-// Set contrast.
-#define OLED_CONTRAST(contrast) OLED_COMMAND( \
-        spi2ExchangeByte(0x81); \
-        spi2ExchangeByte(contrast); \
-    )
-
-// Reset/resume display.
-#define OLED_DISPLAY_RESUME() oledSendCommand(0xA4)
-#define OLED_DISPLAY_RESET() oledSendCommand(0xA5)
 
-// Normal/inverse mode.
-#define OLED_DISPLAY_NORMAL() oledSendCommand(0xA6)
-#define OLED_DISPLAY_INVERSE() oledSendCommand(0xA7)
-
-// Display on/off.
-#define OLED_DISPLAY_OFF() oledSendCommand(0xAE)
-#define OLED_DISPLAY_ON() oledSendCommand(0xAF)
-
-////////////////////////////////////////////////////////////////////////
-
-
-////////////////////////////////////////////////////////////////////////
-// Addressing OLED Commands (low level)
-////////////////////////////////////////////////////////////////////////
-
-// Only horizontal addressing mode commands are implemented here as the
-// frame buffer is setup to be addressed in this way.
-
-// Set addressing mode.
-#define OLED_HORIZONTAL_MODE() OLED_COMMAND( \
-        spi2ExchangeByte(0x20); \
-        spi2ExchangeByte(0b00); \
-    )
-#define OLED_VERTICAL_MODE() OLED_COMMAND( \
-        spi2ExchangeByte(0x20); \
-        spi2ExchangeByte(0b01); \
-    )
-#define OLED_PAGE_MODE() OLED_COMMAND( \
-        spi2ExchangeByte(0x20); \
-        spi2ExchangeByte(0b10); \
-    )
-
-// Set column range (horizontal or vertical addressing mode).
-#define OLED_COLUMN_RANGE(start, end) OLED_COMMAND( \
-        spi2ExchangeByte(0x21); \
-        spi2ExchangeByte(start); \
-        spi2ExchangeByte(end); \
-    )
-
-// Set page range (horizontal or vertical addressing mode).
-#define OLED_PAGE_RANGE(start, end) OLED_COMMAND( \
-        spi2ExchangeByte(0x22); \
-        spi2ExchangeByte(start); \
-        spi2ExchangeByte(end); \
-    )
-
-////////////////////////////////////////////////////////////////////////
-
-
-////////////////////////////////////////////////////////////////////////
-// Hardware Configuration OLED Commands (low level)
-////////////////////////////////////////////////////////////////////////
-
-// Set display RAM start line (0-63).
-#define OLED_START_LINE(line) oledSendCommand(0b01000000 | (line & 0b00111111))
-
-// Use normal/reverse column mapping.
-#define OLED_NORMAL_COLUMN() oledSendCommand(0xA0)
-#define OLED_REVERSE_COLUMN() oledSendCommand(0xA1)
-
-// Set the multiplex ratio to (16 <= mux <= 64).
-#define OLED_MULTIPLEX(mux) OLED_COMMAND( \
-        spi2ExchangeByte(0xA8); \
-        spi2ExchangeByte(mux-1); \
-    )
-
-// Set normal/reverse row mapping.
-#define OLED_NORMAL_ROW() oledSendCommand(0xC0)
-#define OLED_REVERSE_ROW() oledSendCommand(0xC8)
-
-// Set vertical offset from 0 to 63.
-#define OLED_VERTICAL_OFFSET(offset) OLED_COMMAND( \
-        spi2ExchangeByte(0xD3); \
-        spi2ExchangeByte(offset); \
-    )
-
-// Configure COM pins.
-#define OLED_ENABLE_ROW_REMAP 0b00100010
-#define OLED_DISABLE_ROW_REMAP 0b00000010
-#define OLED_SEQ_COM 0b00000010
-#define OLED_ALT_COM 0b00010010
-#define OLED_PIN_CONFIG(config) OLED_COMMAND( \
-        spi2ExchangeByte(0xDA); \
-        spi2ExchangeByte(config); \
-    )\
-
-////////////////////////////////////////////////////////////////////////
-
-
-////////////////////////////////////////////////////////////////////////
-// Timing and Driving Scheme OLED Commands (low level)
-////////////////////////////////////////////////////////////////////////
-
-// Set clock frequency (0-15) and display clock divisor (1-16).
-#define OLED_CLOCK(freq, div) OLED_COMMAND( \
-        spi2ExchangeByte(0xD5); \
-        spi2ExchangeByte(((uint8_t)freq) << 4 | ((uint8_t)div-1)); \
-    )
-
-// Set phase 1 and phase 2 pre-charge periods in 1 to 15 display clock
-// ticks.
-#define OLED_PRECHARGE_PERIOD(phase1, phase2) OLED_COMMAND( \
-        spi2ExchangeByte(0xD9); \
-        spi2ExchangeByte(((uint8_t)phase2) << 4 | ((uint8_t)phase1)); \
-    )
-
-// Choose 0.65*Vcc as Vcomh deselect.
-#define OLED_VCOMH_064VCC() OLED_COMMAND( \
-        spi2ExchangeByte(0xDB); \
-        spi2ExchangeByte(0x00); \
-    )
-// Choose 0.77*Vcc as Vcomh deselect (default).
-#define OLED_VCOMH_077VCC() OLED_COMMAND( \
-        spi2ExchangeByte(0xDB); \
-        spi2ExchangeByte(0x20); \
-    )
-// Choose 0.83*Vcc as Vcomh deselect (default).
-#define OLED_VCOMH_083VCC() OLED_COMMAND( \
-        spi2ExchangeByte(0xDB); \
-        spi2ExchangeByte(0x30); \
-    )
-
-// No operation.
-#define OLED_NOP() oledSendCommand(0xE3)
-
-////////////////////////////////////////////////////////////////////////
-
-
-////////////////////////////////////////////////////////////////////////
-// Charge Pump OLED Commands (low level)
-////////////////////////////////////////////////////////////////////////
+// Description:
+//      Send a command with one argument in one chip select.  Call with
+//      an OLED_CMD_* macro, which expands to the arguments.
+//
+// Input:
+//      uint8_t command:
+//          Command byte.
+//
+//      uint8_t arg:
+//          Argument byte.
+//
+static void __oledCommand1(uint8_t command, uint8_t arg){
+    OLED_COMMAND(
+        spi2ExchangeByte(command);
+        spi2ExchangeByte(arg);
+    );
+}
 
-// Enable/disable 7.5 V charge pump.
-#define OLED_CHARGE_PUMP_ENABLE() OLED_COMMAND( \
-        spi2ExchangeByte(0x8D); \
-        spi2ExchangeByte(0x14); \
-    )
-#define OLED_CHARGE_PUMP_DISABLE() OLED_COMMAND( \
-        spi2ExchangeByte(0x8D); \
-        spi2ExchangeByte(0x14); \
-    )
 
-////////////////////////////////////////////////////////////////////////
+// Description:
+//      Send a command with two arguments in one chip select.  Call with
+//      an OLED_CMD_* macro, which expands to the arguments.
+//
+// Input:
+//      uint8_t command:
+//          Command byte.
+//
+//      uint8_t arg0, arg1:
+//          Argument bytes.
+//
+static void __oledCommand2(uint8_t command, uint8_t arg0, uint8_t arg1){
+    OLED_COMMAND(
+        spi2ExchangeByte(command);
+        spi2ExchangeByte(arg0);
+        spi2ExchangeByte(arg1);
+    );
+}
 
 
 // Description:
@@ -274,6 +163,28 @@ static void __oledInitCom(void){
 }
 
 
+// SSD1306 initialization (most of these are taken from the Adafruit
+// SSD1306 library).
+static const rom uint8_t initCommands[] = {
+    OLED_CMD_DISPLAY_OFF(),             // turn off display
+    OLED_CMD_CLOCK(8, 1),               // Fosc = speed 8, clock = Fosc
+    OLED_CMD_MULTIPLEX(64),             // MUX = 64
+    OLED_CMD_VERTICAL_OFFSET(0),        // no vertical offset
+    OLED_CMD_START_LINE(0),             // start at line 0 of RAM
+    OLED_CMD_CHARGE_PUMP_ENABLE(),      // enable 7.5V charge pump
+    OLED_CMD_ADDRESSING(OLED_VERTICAL_MODE),
+    OLED_CMD_REVERSE_COLUMN(),          // reverse column addressing
+    OLED_CMD_REVERSE_ROW(),             // reverse row addressing
+    OLED_CMD_PIN_CONFIG(OLED_DISABLE_ROW_REMAP | OLED_ALT_COM),
+    OLED_CMD_CONTRAST(127),             // set contrast to 0.5
+    OLED_CMD_PRECHARGE_PERIOD(1, 15),   // 1 and 15 DCLK
+    OLED_CMD_VCOMH_077VCC(),            // Vcomh deselect = 0.77 * Vcc
+    OLED_CMD_DISPLAY_RESUME(),          // resume display
+    OLED_CMD_DISPLAY_NORMAL(),          // normal display mode
+    OLED_CMD_DISPLAY_ON()               // turn on OLED panel
+};
+
+
 // Description:
 //      Send initialization/configuration bytes to the OLED controller.
 //
@@ -287,26 +198,102 @@ static void __oledWriteInit(void){
     delayxms(10);       // wait for reset
     OLED_RESET_HIGH();  // tie reset pin high
 
-    // Send initialization commands (most of these are taken from the
-    // Adafruit SSD1306 library).
-    OLED_DISPLAY_OFF();         // turn off display
-    OLED_CLOCK(8, 1);           // Fosc = speed 8, display clock = Fosc
-    OLED_MULTIPLEX(64);         // MUX = 32
-    OLED_VERTICAL_OFFSET(0);    // no vertical offset
-    OLED_START_LINE(0);         // start at line 0 of RAM
-    OLED_CHARGE_PUMP_ENABLE();  // enable 7.5V charge pump
-    OLED_VERTICAL_MODE();       // use vertical addressing mode
-    OLED_REVERSE_COLUMN();      // don't reverse column addressing
-    OLED_REVERSE_ROW();         // reverse row addressing
-    // Configure COM pins.
-    OLED_PIN_CONFIG(OLED_DISABLE_ROW_REMAP | OLED_ALT_COM);
-    OLED_CONTRAST(127);         // set contrast to 0.5
-    // Period 1 = 15 DCLK, period 2 = 1 DCLK.
-    OLED_PRECHARGE_PERIOD(1, 15);
-    OLED_VCOMH_077VCC();        // Vcomh deselect = 0.77 * Vcc
-    OLED_DISPLAY_RESUME();      // resume display
-    OLED_DISPLAY_NORMAL();      // normal display mode
-    OLED_DISPLAY_ON();          // turn on OLED panel
+    // Send initialization commands.
+    OLED_COMMANDS(initCommands);
+}
+
+
+// PIC ADI logo shown at start, run length encoded a page at a time by
+// im2c --rle (359 bytes from 1024).
+static const rom uint8_t splash[] = {
+    0x05, 0x07, 0x07, 0x0F, 0x0F, 0x1F, 0x1F, 0x82,
+    0x3F, 0x01, 0x7F, 0x7F, 0xF4, 0xFF, 0x8D, 0x00,
+    0x03, 0x01, 0x01, 0x03, 0x03, 0x82, 0x07, 0x01,
+    0x0F, 0x0F, 0x82, 0x1F, 0x03, 0x3F, 0x3F, 0x7F,
+    0x7F, 0xE1, 0xFF, 0x89, 0x00, 0x8C, 0xC0, 0x00,
+    0x80, 0x86, 0x00, 0x11, 0xC0, 0xC0, 0xC1, 0xC1,
+    0xC3, 0x03, 0x03, 0x07, 0x07, 0x0F, 0x0F, 0x1F,
+    0x9F, 0x9F, 0xBF, 0xFF, 0xBF, 0xBF, 0x83, 0x3F,
+    0x01, 0x7F, 0x7F, 0x94, 0xFF, 0x86, 0x3F, 0x8A,
+    0xFF, 0x8A, 0x3F, 0x82, 0x7F, 0x88, 0xFF, 0x84,
+    0x3F, 0x85, 0xFF, 0x87, 0x00, 0x00, 0xE0, 0x83,
+    0xFF, 0x00, 0xBF, 0x84, 0x83, 0x01, 0xC3, 0xC7,
+    0x83, 0xFF, 0x00, 0x3E, 0x82, 0x00, 0x00, 0xE0,
+    0x83, 0xFF, 0x0C, 0x3F, 0x01, 0x00, 0x80, 0xF0,
+    0xF8, 0xFC, 0xFE, 0x7F, 0x1F, 0x0F, 0x07, 0x07,
+    0x84, 0x03, 0x08, 0x06, 0x06, 0x0C, 0x02, 0x03,
+    0x07, 0x07, 0x0F, 0x0F, 0x82, 0x1F, 0x01, 0x3F,
+    0x3F, 0x82, 0x7F, 0x09, 0xFF, 0xFF, 0x7F, 0x1F,
+    0x07, 0x03, 0x00, 0x00, 0xC0, 0xE0, 0x83, 0x00,
+    0x00, 0x0F, 0x87, 0xFF, 0x01, 0x3F, 0x01, 0x82,
+    0x00, 0x00, 0xC0, 0x84, 0xFC, 0x02, 0xF8, 0xF8,
+    0xF0, 0x82, 0x00, 0x01, 0x01, 0x07, 0x83, 0xFF,
+    0x01, 0x3F, 0x01, 0x82, 0x00, 0x01, 0xC0, 0xFE,
+    0x85, 0xFF, 0x85, 0x00, 0x01, 0x80, 0xFC, 0x83,
+    0xFF, 0x88, 0x07, 0x02, 0x03, 0x03, 0x01, 0x82,
+    0x00, 0x01, 0x80, 0xFC, 0x83, 0xFF, 0x00, 0x07,
+    0x82, 0x00, 0x01, 0x1F, 0x7F, 0x82, 0xFF, 0x01,
+    0xF0, 0xE0, 0x85, 0xC0, 0x02, 0xE0, 0xE0, 0xF0,
+    0x8C, 0x00, 0x0D, 0x80, 0xC0, 0xF0, 0xFC, 0xFE,
+    0xFE, 0x7E, 0x7C, 0x7C, 0x78, 0x7F, 0x7F, 0x77,
+    0x74, 0x82, 0xE0, 0x04, 0xC0, 0xC3, 0xBF, 0x7F,
+    0x7F, 0x82, 0xFF, 0x00, 0x07, 0x83, 0x00, 0x00,
+    0x38, 0x83, 0x3F, 0x09, 0x1F, 0x1F, 0x0F, 0x07,
+    0x01, 0x80, 0x80, 0xE0, 0xF0, 0xFC, 0x82, 0xFF,
+    0x00, 0x07, 0x83, 0x00, 0x00, 0xF8, 0x87, 0xFF,
+    0x85, 0x00, 0x84, 0x03, 0x8F, 0x00, 0x84, 0x03,
+    0x87, 0x00, 0x01, 0x01, 0x01, 0x87, 0x03, 0x01,
+    0x01, 0x01, 0x8C, 0x00, 0x00, 0x02, 0x84, 0x03,
+    0x00, 0x01, 0x88, 0x00, 0x84, 0x03, 0x83, 0x00,
+    0x01, 0x02, 0x02, 0x82, 0x00, 0x01, 0x04, 0x04,
+    0x82, 0x0C, 0x01, 0x1C, 0x1C, 0x82, 0x3E, 0x01,
+    0x7F, 0x7F, 0x85, 0xFF, 0x84, 0xFC, 0x89, 0xFF,
+    0xEC, 0x00, 0x82, 0x01, 0x03, 0x03, 0x03, 0x07,
+    0x07, 0x82, 0x0F, 0x01, 0x1F, 0x1F, 0x82, 0x3F,
+    0x03, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x00,
+};
+
+
+// Store a splash byte, past the last column go to the next page.
+#define SPLASH_STORE(byte) do { \
+        *dst = (byte); \
+        dst += 8; \
+        if (dst >= frameBuffer + OLED_SIZE){ \
+            dst -= OLED_SIZE - 1; \
+        } \
+    } while (0)
+
+
+// Description:
+//      Decode the splash screen into the frame buffer.  Each packet is a
+//      control byte of 0x80 | (n - 1) followed by a byte repeated n times
+//      or of n - 1 followed by n literal bytes.  Bytes are stored a page
+//      at a time, every 8th byte of the frame buffer.
+//
+static void __oledSplash(void){
+
+    const rom uint8_t *src;
+    uint8_t *dst;
+    uint16_t left;
+    uint8_t control, n, value;
+
+    src = splash;
+    dst = frameBuffer;
+    for (left = OLED_SIZE; left != 0; ){
+        control = *src++;
+        n = (control & 0x7F) + 1;
+        left -= n;
+        if (control & 0x80){
+            value = *src++;
+            do {
+                SPLASH_STORE(value);
+            } while (--n);
+        } else {
+            do {
+                SPLASH_STORE(*src++);
+            } while (--n);
+        }
+    }
 }
 
 
@@ -317,162 +304,102 @@ void oledInit(void){
 
     // Write initialization string to OLED.
     __oledWriteInit();
+
+    // Load the splash screen.
+    __oledSplash();
 }
 
 
 void oledWriteBuffer(void){
 
-    uint16_t i;
+    // Use the whole display without scrolling.
+    if (startLine != 0){
+        oledSetStartLine(0);
+    }
+    if (windowed){
+        oledWindow(0, OLED_WIDTH - 1, 0, OLED_HEIGHT/8 - 1);
+    }
 
     // Write frame buffer to OLED RAM.
+    OLED_DATA(spi2Write(frameBuffer, OLED_SIZE););
+}
+
+
+void oledCommands(const rom uint8_t *table, uint8_t length){
+    OLED_COMMAND(spi2WriteROM(table, length););
+}
+
+
+void oledContrast(uint8_t contrast){
+    __oledCommand1(OLED_CMD_CONTRAST(contrast));
+}
+
+
+void oledAddressing(uint8_t mode){
+    __oledCommand1(OLED_CMD_ADDRESSING(mode));
+}
+
+
+void oledWindow(uint8_t column0, uint8_t column1,
+                uint8_t page0, uint8_t page1){
+    __oledCommand2(OLED_CMD_COLUMN_RANGE(column0, column1));
+    __oledCommand2(OLED_CMD_PAGE_RANGE(page0, page1));
+    windowed = column0 != 0 || column1 != OLED_WIDTH - 1 ||
+               page0 != 0 || page1 != OLED_HEIGHT/8 - 1;
+}
+
+
+void oledSetStartLine(uint8_t line){
+    startLine = line & 0b00111111;
+    oledSendCommand(OLED_CMD_START_LINE(startLine));
+}
+
+
+void oledWriteRows(uint8_t column0, uint8_t column1,
+                   uint8_t page0, uint8_t page1){
+
+    uint8_t column[OLED_HEIGHT/8];
+    uint8_t *src;
+    uint8_t c, i, n, k, shift;
+
+    oledWindow(column0, column1, page0, page1);
+
+    // Display RAM row r holds frame buffer row r - startLine, so unless
+    // the start line is a multiple of 8 each page is the last <shift>
+    // rows of frame buffer byte k - 1 followed by the first rows of k.
+    shift = startLine & 0b00000111;
+    n = page1 - page0 + 1;
+    src = frameBuffer + (uint16_t)column0*(OLED_HEIGHT/8);
     OLED_DATA(
-        for (i = 0; i < OLED_SIZE; ++i){
-            spi2ExchangeByte(frameBuffer[i]);
+        for (c = column0; c <= column1; ++c){
+            k = (page0 - (startLine >> 3)) & 0b00000111;
+            for (i = 0; i < n; ++i){
+                if (shift == 0){
+                    column[i] = src[k];
+                } else {
+                    column[i] = src[k] << shift |
+                                src[(k - 1) & 0b00000111] >> (8 - shift);
+                }
+                k = (k + 1) & 0b00000111;
+            }
+            spi2Write(column, n);
+            src += OLED_HEIGHT/8;
         }
     );
 }
 
 
 void oledNormal(void){
-    OLED_DISPLAY_NORMAL();
+    oledSendCommand(OLED_CMD_DISPLAY_NORMAL());
 }
 
 
 void oledInverse(void){
-    OLED_DISPLAY_INVERSE();
+    oledSendCommand(OLED_CMD_DISPLAY_INVERSE());
 }
 
 
-// Frame buffer, shows PIC ADI logo at start.
-#pragma idata framBuffer
-uint8_t frameBuffer[OLED_SIZE] = {
-    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x3F, 0x00, 0x00, 0x00, 0x80, 0x03, 0x00, 0x00,
-    0x3F, 0x00, 0x00, 0x00, 0xFC, 0x03, 0x00, 0x00,
-    0x3F, 0x00, 0x00, 0xE0, 0xFF, 0x03, 0x00, 0x00,
-    0x7F, 0x00, 0x00, 0xFF, 0xFF, 0x03, 0x00, 0x00,
-    0x7F, 0x00, 0xC0, 0xFF, 0xFF, 0x03, 0x00, 0x00,
-    0xFF, 0x00, 0xC0, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-    0xFF, 0x00, 0xC0, 0xFF, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x00, 0xC0, 0xBF, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x01, 0xC0, 0x83, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x01, 0xC0, 0x83, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x03, 0xC0, 0x83, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x03, 0xC0, 0x83, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x07, 0xC0, 0x83, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x07, 0xC0, 0xC3, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x07, 0xC0, 0xC7, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0x0F, 0xC0, 0xFF, 0x03, 0x00, 0x00, 0x00,
-    0xFF, 0x0F, 0xC0, 0xFF, 0x03, 0x00, 0x00, 0x00,
-    0xFF, 0x1F, 0x80, 0xFF, 0x01, 0x00, 0x00, 0x00,
-    0xFF, 0x1F, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0x1F, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0x3F, 0x00, 0x00, 0x80, 0x03, 0x00, 0x00,
-    0xFF, 0x7F, 0x00, 0x00, 0xFC, 0x03, 0x00, 0x00,
-    0xFF, 0x7F, 0x00, 0xE0, 0xFF, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xC0, 0xFF, 0xFF, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xC0, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xC1, 0xFF, 0x07, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xC1, 0x3F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xC3, 0x01, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x03, 0x80, 0x1F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x07, 0xF0, 0x7F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x07, 0xF8, 0xFF, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x0F, 0xFC, 0xFF, 0x01, 0x00, 0x00,
-    0xFF, 0xFF, 0x0F, 0xFE, 0xFF, 0x01, 0x00, 0x00,
-    0xFF, 0xFF, 0x1F, 0x7F, 0xF0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x9F, 0x1F, 0xE0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x9F, 0x0F, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xBF, 0x07, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x07, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xBF, 0x03, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xBF, 0x03, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x03, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x03, 0xE0, 0x01, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x03, 0xE0, 0x01, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x06, 0xF0, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x7F, 0x06, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x7F, 0x0C, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x02, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x02, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x7F, 0x80, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x7F, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x7F, 0xF0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x7F, 0xFE, 0x01, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x1F, 0x7E, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x07, 0x7C, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x03, 0x7C, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x00, 0x78, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x7F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xC0, 0x7F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xE0, 0x77, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x74, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0xE0, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0xE0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0xE0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x0F, 0xC0, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x03, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x02, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x04, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x38, 0x04, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xC0, 0x3F, 0x0C, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFC, 0x3F, 0x0C, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFC, 0x3F, 0x0C, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFC, 0x3F, 0x1C, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFC, 0x1F, 0x1C, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFC, 0x1F, 0x3E, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xF8, 0x0F, 0x3E, 0x00, 0x00,
-    0xFF, 0xFF, 0x3F, 0xF8, 0x07, 0x3E, 0x00, 0x00,
-    0xFF, 0xFF, 0x7F, 0xF0, 0x01, 0x7F, 0x00, 0x00,
-    0xFF, 0xFF, 0x7F, 0x00, 0x80, 0x7F, 0x00, 0x00,
-    0xFF, 0xFF, 0x7F, 0x00, 0x80, 0xFF, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x00, 0xE0, 0xFF, 0x00, 0x00,
-    0xFF, 0xFF, 0xFF, 0x01, 0xF0, 0xFF, 0x01, 0x00,
-    0xFF, 0xFF, 0xFF, 0x07, 0xFC, 0xFF, 0x01, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x03, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0xFC, 0x07, 0x00,
-    0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0xFC, 0x07, 0x00,
-    0xFF, 0xFF, 0xFF, 0x01, 0x00, 0xFC, 0x0F, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x00, 0xFC, 0x0F, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0x00, 0xFF, 0x0F, 0x00,
-    0xFF, 0xFF, 0x3F, 0x00, 0xF8, 0xFF, 0x1F, 0x00,
-    0xFF, 0xFF, 0x3F, 0xC0, 0xFF, 0xFF, 0x1F, 0x00,
-    0xFF, 0xFF, 0x3F, 0xFE, 0xFF, 0xFF, 0x3F, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
-};
-#pragma idata
+// Frame buffer, in its own 1 KB bank given by the linker script.
+#pragma udata framBuffer
+uint8_t frameBuffer[OLED_SIZE];
+#pragma udata
@@ -8,9 +8,10 @@
 // Device: PIC18F87K22
 // Compiler: C18
 //
-// NOTE: The LED and LCD libraries are not actually used.  There where
-//       included in this project to aid with debugging but are not used
-//       in the production code.
+// NOTE: The LED and LCD libraries are not actually used, only the LED
+//       macros light the calibration LEDs.  There where included in
+//       this project to aid with debugging but are not used in the
+//       production code.
 //
 ////////////////////////////////////////////////////////////////////////
 
@@ -23,7 +24,16 @@
 #include "oled.h"
 #include "efis.h"
 #include "imu.h"
+#include "magcal.h"
+#include "led.h"
 #include "ahrs.h"
+#include "sched.h"
+#include "profile.h"
+#include "uart.h"
+#include "telemetry.h"
+#include "recorder.h"
+#include "spitrace.h"
+#include "scroll.h"
 
 
 #pragma config FOSC=HS1, PWRTEN=ON, BOREN=ON, BORV=2, PLLCFG=ON
@@ -51,37 +61,296 @@ void lowVector(void){
 #pragma code
 
 
-void main(){
+// Attitude shared by the AHRS and render tasks.
+#ifdef AHRS_CACHED_TRIG
+static struct attitude att;
+#else
+static int16_t yaw, pitch, roll;
+#endif
+static bool valid = false;
+static bool started = false;  // set once the AHRS has run
+
+
+// Milliseconds from enabling interrupts to the first valid frame,
+// zero until then.  Can be read with the debugger.
+uint16_t bootTime = 0;
+
+
+// Frame pacing.  When frames run over RENDER_BUDGET optional EFIS layers
+// are turned off one at a time in the order below, and turned back on
+// in reverse order once there is enough headroom again.
+#define PACE_SHED_FRAMES 2      // frames over budget before shedding
+#define PACE_RESTORE_FRAMES 25  // frames with headroom before restoring
+#define PACE_HYSTERESIS 4       // milliseconds of headroom to restore
+#define PACE_LEVELS 3
+static const rom uint8_t paceShedOrder[PACE_LEVELS] = {
+    EFIS_LAYER_INVALID_CROSS, EFIS_LAYER_ROLL_FINE, EFIS_LAYER_PITCH_FINE
+};
+
+
+// Milliseconds left of the render budget after the last frame (negative
+// when over budget) and the least seen.  Can be read with the debugger.
+int16_t renderHeadroom = 0;
+int16_t renderHeadroomMin = INT16_MAX;
+
+
+// Description:
+//      Frame budget controller, turns optional EFIS layers off and on
+//      to keep the render time within RENDER_BUDGET.
+//
+// Input:
+//      uint16_t frameTime:
+//          Milliseconds taken to draw and write the last frame.
+//
+static void renderPace(uint16_t frameTime){
+
+    static uint8_t level = 0;   // number of layers turned off
+    static uint8_t over = 0;    // consecutive frames over budget
+    static uint8_t under = 0;   // consecutive frames with headroom
+
+    renderHeadroom = (int16_t)RENDER_BUDGET - (int16_t)frameTime;
+    if (renderHeadroom < renderHeadroomMin){
+        renderHeadroomMin = renderHeadroom;
+    }
+
+    if (renderHeadroom < 0){
+        // Over budget, shed a layer.
+        under = 0;
+        if (++over >= PACE_SHED_FRAMES && level < PACE_LEVELS){
+            efisLayers &= ~paceShedOrder[level];
+            ++level;
+            over = 0;
+        }
+    } else if (renderHeadroom >= PACE_HYSTERESIS){
+        // Enough headroom, restore a layer.
+        over = 0;
+        if (++under >= PACE_RESTORE_FRAMES && level > 0){
+            --level;
+            efisLayers |= paceShedOrder[level];
+            under = 0;
+        }
+    } else {
+        over = 0;
+        under = 0;
+    }
+}
+
+
+// Description:
+//      AHRS task, updates the attitude solution.
+//
+static void ahrsTask(void){
+
+    // Wait for the IMU buffers to fill.
+    if (!imuReady()){
+        return;
+    }
+
+    PROFILE_BEGIN(PROFILE_AHRS);
+#ifdef AHRS_CACHED_TRIG
+    valid = ahrsUpdate_(&att);
+#else
+    valid = ahrsUpdate(&yaw, &pitch, &roll);
+#endif
+    PROFILE_END(PROFILE_AHRS);
+    started = true;
+
+#ifdef RECORDER
+#ifdef AHRS_CACHED_TRIG
+    recorderAttitude(att.yaw, att.pitch, att.roll, valid);
+#else
+    recorderAttitude(yaw, pitch, roll, valid);
+#endif
+#endif
+}
+
+
+// Magnetometer calibration button, S1 pulls RB0 low when pressed.  LED
+// D2 is lit while calibrating and D3 when the last calibration failed.
+#define CAL_BUTTON_INPUT() (TRISBbits.TRISB0 = 1)
+#define CAL_BUTTON_PRESSED() (PORTBbits.RB0 == 0)
+#define CAL_LEDS_OUTPUT() do { \
+        TRISBbits.TRISB5 = 0; \
+        TRISBbits.TRISB6 = 0; \
+    } while (0)
+
+
+// Description:
+//      Calibration task, polls the calibration button.  A press starts
+//      magnetometer calibration (see magcal.h) and the next press
+//      finishes it, so holding the button through reset calibrates
+//      from boot.  Polling every MAGCAL_PERIOD milliseconds debounces
+//      the button.
+//
+static void magcalTask(void){
+
+    static bool down = false;
+    bool pressed;
+
+    pressed = CAL_BUTTON_PRESSED();
+    if (pressed && !down){
+        if (magcalActive()){
+            LED_D2_OFF();
+            if (!magcalFinish()){
+                LED_D3_ON();
+            }
+        } else {
+            LED_D3_OFF();
+            LED_D2_ON();
+            magcalStart();
+        }
+    }
+    down = pressed;
+}
+
 
-    int16_t yaw, pitch, roll;
-    bool valid;
+#ifdef TELEMETRY
+// Telemetry rate dividers, in telemetry task periods.
+#define TLM_VECTORS_DIVIDER 4
+#define TLM_PROFILE_DIVIDER 20
+#define TLM_STATUS_DIVIDER 100
+
+
+// Description:
+//      Telemetry task, sends the selected channels.  The raw IMU and
+//      attitude channels are sent every period and the others every
+//      divider periods.
+//
+static void telemetryTask(void){
+
+    static uint8_t count = 0;
+
+    telemetryRawImu();
+    if (started){
+#ifdef AHRS_CACHED_TRIG
+        telemetryAttitude(att.yaw, att.pitch, att.roll, valid);
+#else
+        telemetryAttitude(yaw, pitch, roll, valid);
+#endif
+    }
+    if (count % TLM_VECTORS_DIVIDER == 0){
+        telemetryVectors();
+    }
+#ifdef PROFILE
+    if (count % TLM_PROFILE_DIVIDER == 0){
+        telemetryProfile();
+    }
+#endif
+    if (count == 0){
+        telemetryStatus(bootTime, renderHeadroom, renderHeadroomMin,
+                        efisLayers);
+    }
+#ifdef SPI_TRACE
+    telemetrySpiTrace();
+#endif
+    if (++count == TLM_STATUS_DIVIDER){
+        count = 0;
+    }
+}
+#endif
+
+
+// Description:
+//      Render task, draws the EFIS and writes it to the OLED.
+//
+static void renderTask(void){
+
+    uint16_t start;
+
+    // Keep the splash screen until the IMU buffers are full and there
+    // is an attitude solution.
+    if (!started){
+        return;
+    }
+    start = schedTicks();
+
+    PROFILE_BEGIN(PROFILE_EFIS);
+#ifdef AHRS_CACHED_TRIG
+    // Write the EFIS to the frame buffer, reusing the roll trig
+    // functions from the AHRS.
+    efisDraw_(att.yaw, att.pitch, att.rollSin, att.rollCos, valid);
+#else
+    // Write the EFIS to the frame buffer.
+    efisDraw(yaw, pitch, roll, valid);
+#endif
+    PROFILE_END(PROFILE_EFIS);
+
+#ifdef PROFILE
+    // Show the profile report in place of the EFIS, the next frame is
+    // drawn whole.
+    profileDraw();
+    efisInvalidate();
+#endif
+
+    // Write the frame buffer, the profile report is not scrolled.
+    PROFILE_BEGIN(PROFILE_OLED);
+#if defined(EFIS_SCROLL) && !defined(PROFILE)
+    scrollWrite();
+#else
+    oledWriteBuffer();
+#endif
+    PROFILE_END(PROFILE_OLED);
+
+    // Keep the next frame within budget.
+    renderPace((schedTicks() - start)*SCHED_TICK_MS);
+
+    // Record the time to the first valid frame.
+    if (bootTime == 0 && valid){
+        bootTime = schedTicks()*SCHED_TICK_MS;
+    }
+}
+
+
+void main(){
 
     // Initialize all subsystems.
+#ifdef SPI_TRACE
+    spiTraceInit();     // first, so the OLED setup is traced too
+#endif
     oledInit();
     oledWriteBuffer();
     imuInit();
+#ifdef RECORDER
+    recorderInit();
+#endif
+    schedInit();
+#ifdef PROFILE
+    profileInit();
+#endif
+#ifdef TELEMETRY
+    telemetryInit(TELEMETRY_CHANNELS);
+#endif
 
     // Enable interrupts.
     RCONbits.IPEN = 1;      // Enable priority levels
     INTCONbits.GIEL = 1;    // Enable low-priority interrupts to CPU.
     INTCONbits.GIEH = 1;    // Enable all interrupts.
 
-    // Spin-up IMU and delay on splash screen.
-    imuSpinup();
-    delayxs(2);
+    // Load magnetometer calibration and set up its button.
+    magcalInit();
+    CAL_BUTTON_INPUT();
+    CAL_LEDS_OUTPUT();
+    LED_D2_OFF();
+    LED_D3_OFF();
 
-    // Main loop.
-    while (true){
-
-        /* // Update AHRS solution. */
-        valid = ahrsUpdate(&yaw, &pitch, &roll);
+    // Spin-up IMU, the splash screen is shown until the IMU buffers are
+    // full.
+    imuSpinup();
 
-        // Write the EFIS to the frame buffer.
-        efisDraw(yaw, pitch, roll, valid);
+    // Add tasks in order of priority, the render task is offset so it
+    // is not released on the same tick as the AHRS task.
+    schedAdd(ahrsTask, AHRS_PERIOD, AHRS_PERIOD, 0);
+#ifdef TELEMETRY
+    schedAdd(telemetryTask, TELEMETRY_PERIOD, TELEMETRY_PERIOD, 1);
+#endif
+    schedAdd(renderTask, RENDER_PERIOD, RENDER_PERIOD, AHRS_PERIOD/2);
+    schedAdd(magcalTask, MAGCAL_PERIOD, MAGCAL_PERIOD, 2);
+#ifdef RECORDER
+    schedBackground(recorderTask);
+#endif
 
-        // Write the frame buffer.
-        oledWriteBuffer();
-    }
+    // Main loop.
+    schedRun();
 }
 
 
@@ -90,7 +359,9 @@ void main(){
 //
 #pragma interrupt isrh
 void isrh(void){
-    // high priority interrupt code
+    if (SCHED_TICK_FLAG){
+        schedISR();
+    }
 }
 
 
@@ -103,4 +374,7 @@ void isrl(void){
     while(IMU_INT_FLAG) {
         imuISR();
     }
+    if (UART_TX_INT_FLAG && UART_TX_INT_ENABLE){
+        uartISR();
+    }
 }
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////
+// File: profile.c
+// Header: profile.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include <stdio.h>
+#ifdef PROFILE_HOST_CLOCK
+#include <time.h>
+#endif
+#include "config.h"
+#include "stdint.h"
+#include "util.h"
+#include "graphics.h"
+#include "profile.h"
+
+
+// Timer 1 settings, Fosc/4 clock, 16-bit reads, timer on.
+#if PROFILE_PRESCALE == 8
+#define TMR1_PRESCALE 0b00110000
+#elif PROFILE_PRESCALE == 4
+#define TMR1_PRESCALE 0b00100000
+#elif PROFILE_PRESCALE == 2
+#define TMR1_PRESCALE 0b00010000
+#else
+#define TMR1_PRESCALE 0b00000000
+#endif
+#define TMR1_RD16 0b00000010
+#define TMR1_ON 0b00000001
+
+
+void profileInit(void){
+    T1GCON = 0;
+    TMR1H = 0;
+    TMR1L = 0;
+    T1CON = TMR1_PRESCALE | TMR1_RD16 | TMR1_ON;
+#ifdef PROFILE
+    profileClear();
+#endif
+}
+
+
+#ifdef PROFILE_HOST_CLOCK
+uint16_t profileTime(void){
+
+    struct timespec t;
+
+    // Microseconds, wrapping like the timer.
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint16_t)(t.tv_sec*1000000UL + t.tv_nsec/1000);
+}
+#else
+uint16_t profileTime(void){
+
+    union bytes2 t;
+
+    // Reading the low byte latches the high byte.
+    t.uint8A = TMR1L;
+    t.uint8B = TMR1H;
+
+    return t.uint16;
+}
+#endif
+
+
+#ifdef PROFILE
+// Section names for the report.
+static const rom char names[PROFILE_SECTIONS][5] = {
+    "AHRS", "EFIS", "HORZ", "PTCH", "ROLL", "COMP", "OLED"
+};
+
+
+// Section statistics.
+struct profileSection profileSections[PROFILE_SECTIONS];
+
+
+void profileClear(void){
+
+    uint8_t i;
+
+    for (i = 0; i < PROFILE_SECTIONS; ++i){
+        profileSections[i].min = 0xFFFF;
+        profileSections[i].max = 0;
+        profileSections[i].sum = 0;
+        profileSections[i].count = 0;
+    }
+}
+
+
+void profileEnd(uint8_t id){
+
+    uint16_t time;
+    struct profileSection *section;
+
+    section = &profileSections[id];
+    time = profileTime() - section->start;
+
+    // Stop at the maximum count so the sum can not overflow.
+    if (section->count == 0xFFFF){
+        return;
+    }
+
+    if (time < section->min){
+        section->min = time;
+    }
+    if (time > section->max){
+        section->max = time;
+    }
+    section->sum += time;
+    ++section->count;
+}
+
+
+void profileDraw(void){
+
+    uint8_t i;
+    uint16_t mean;
+    char buffer[22];
+    struct profileSection *section;
+
+    glClear();
+    glString(0, 0, GL_COLOR_WHITE, str("sect  mean   max    n"));
+
+    for (i = 0; i < PROFILE_SECTIONS; ++i){
+
+        section = &profileSections[i];
+        mean = 0;
+        if (section->count > 0){
+            mean = section->sum/section->count;
+        }
+
+        sprintf(buffer, STR("%-4s%6u%6u%5u"), str(names[i]),
+                (uint16_t)profileToUs(mean),
+                (uint16_t)profileToUs(section->max), section->count);
+        buffer[21] = '\0';
+        glString(i+1, 0, GL_COLOR_WHITE, buffer);
+    }
+}
+#endif // PROFILE
@@ -0,0 +1,312 @@
+///////////////////////////////////////////////////////////////////////
+// File: recorder.c
+// Header: recorder.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "util.h"
+#include "eeprom.h"
+#include "sdcard.h"
+#include "sched.h"
+#include "recorder.h"
+
+
+// Block buffers, each fills a bank (gpr4 and gpr5 in the linker
+// script).
+#pragma udata recBufferA
+static uint8_t bufferA[RECORDER_BUFFER_SIZE];
+#pragma udata recBufferB
+static uint8_t bufferB[RECORDER_BUFFER_SIZE];
+#pragma udata
+
+
+// Buffer state.  The interrupt fills buffers[fill] and marks it full
+// when the next record does not fit.  recorderTask writes full buffers
+// and marks them empty again once the card is done.
+static uint8_t *buffers[2];
+static uint32_t blocks[2];          // card block of each buffer
+static volatile bool full[2];
+static volatile uint8_t fill;       // buffer being filled
+static uint16_t length;             // bytes used in buffers[fill]
+
+
+// Session state.
+static bool starting = false;       // bringing up the card
+static bool storing = false;        // writing the session number
+static bool active = false;
+static uint16_t session;
+static uint32_t base;               // first block of the session
+static uint32_t sequence;           // next block of the session
+
+
+// Statistics.
+uint16_t recorderDrops = 0;
+uint16_t recorderErrors = 0;
+uint32_t recorderBlocks = 0;
+
+
+// Change temporary data section, the following are used by the low
+// priority interrupt.
+#pragma tmpdata recorder_tmpdata
+// Description:
+//      Store a 16-bit value as two little endian bytes.
+//
+// Input:
+//      uint8_t *dst:
+//          Location to store value at.
+//
+//      uint16_t value:
+//          Value to store.
+//
+static void put16(uint8_t *dst, uint16_t value){
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+
+// Description:
+//      Start the next block of the session in a buffer.
+//
+// Input:
+//      uint8_t idx:
+//          Buffer to start the block in.
+//
+static void recorderStartBlock(uint8_t idx){
+
+    uint8_t *buffer = buffers[idx];
+
+    buffer[0] = RECORDER_MAGIC0;
+    buffer[1] = RECORDER_MAGIC1;
+    put16(&buffer[2], session);
+    put16(&buffer[4], (uint16_t)sequence);
+    put16(&buffer[6], (uint16_t)(sequence >> 16));
+
+    blocks[idx] = base + sequence;
+    ++sequence;
+    length = RECORDER_HEADER_LENGTH;
+}
+
+
+// Description:
+//      Add a record to the block being filled.  Must be called from the
+//      low priority interrupt or with it disabled.
+//
+// Input:
+//      const uint8_t *record:
+//          Record to add.
+//
+//      uint8_t len:
+//          Length of the record.
+//
+static void recorderAppend(const uint8_t *record, uint8_t len){
+
+    uint8_t i;
+    uint8_t *dst;
+
+    if (!active){
+        return;
+    }
+
+    // Hand the block to recorderTask when the record does not fit.
+    if (!full[fill] && length + len > RECORDER_BUFFER_SIZE){
+        if (length < RECORDER_BUFFER_SIZE){
+            buffers[fill][length] = RECORDER_END;
+        }
+        full[fill] = true;
+    }
+
+    // Move on to the other buffer, unless it has not been written yet.
+    if (full[fill]){
+        if (full[fill ^ 1]){
+            ++recorderDrops;
+            return;
+        }
+        if (sequence >= RECORDER_SESSION_BLOCKS){
+            active = false;
+            return;
+        }
+        fill ^= 1;
+        recorderStartBlock(fill);
+    }
+
+    // Copy the record.
+    dst = buffers[fill] + length;
+    for (i = 0; i < len; ++i){
+        dst[i] = record[i];
+    }
+    length += len;
+}
+
+
+// Description:
+//      Record a timestamped three axis sample.
+//
+// Input:
+//      uint8_t type:
+//          Record type.
+//
+//      int16_t x, y, z:
+//          Sample.
+//
+static void recorderSample(uint8_t type, int16_t x, int16_t y, int16_t z){
+
+    uint8_t record[9];
+    uint16_t tick;
+
+    // schedTicks would use .tmpdata, read the ticks inline.
+    SCHED_TICKS_ISRL(tick);
+
+    record[0] = type;
+    put16(&record[1], tick);
+    put16(&record[3], x);
+    put16(&record[5], y);
+    put16(&record[7], z);
+
+    recorderAppend(record, sizeof(record));
+}
+
+
+void recorderAcc(int16_t x, int16_t y, int16_t z){
+    recorderSample(RECORDER_ACC, x, y, z);
+}
+
+
+void recorderMag(int16_t x, int16_t y, int16_t z){
+    recorderSample(RECORDER_MAG, x, y, z);
+}
+#pragma tmpdata
+
+
+void recorderInit(void){
+    active = false;
+    starting = true;
+    storing = false;
+    sdInit();
+}
+
+
+// Description:
+//      Take a step of bringing up the card and storing the number of a
+//      new session, start the session once both are done.
+//
+static void recorderStart(void){
+
+    // Bring up the card, then start writing the session number.
+    if (!storing){
+        switch (sdInitStep()){
+            case SDC_INIT_PENDING:
+                return;
+            case SDC_INIT_FAILED:
+                starting = false;
+                return;
+        }
+        eepromRead(RECORDER_EEPROM_ADDRESS, (uint8_t *)&session,
+                   sizeof(session));
+        ++session;  // an erased EEPROM (0xFFFF) starts at session 0
+        eepromWritePage(RECORDER_EEPROM_ADDRESS, (uint8_t *)&session,
+                        sizeof(session));
+        storing = true;
+    }
+
+    // Wait for the write cycle, so no block is written under a session
+    // number the next boot could use again.
+    if (eepromBusy()){
+        return;
+    }
+    storing = false;
+    starting = false;
+
+    // Start a new session.
+    base = RECORDER_START_BLOCK +
+        (uint32_t)(session % RECORDER_SESSIONS)*RECORDER_SESSION_BLOCKS;
+    sequence = 0;
+
+    // Start filling the first buffer, the IMU interrupt adds records
+    // once active is set.
+    buffers[0] = bufferA;
+    buffers[1] = bufferB;
+    full[0] = false;
+    full[1] = false;
+    fill = 0;
+    recorderStartBlock(0);
+
+    active = true;
+}
+
+
+void recorderAttitude(int16_t yaw, int16_t pitch, int16_t roll,
+                      bool valid){
+
+    uint8_t record[10];
+    bool giel;
+
+    record[0] = RECORDER_ATT;
+    put16(&record[1], schedTicks());
+    put16(&record[3], yaw);
+    put16(&record[5], pitch);
+    put16(&record[7], roll);
+    record[9] = valid;
+
+    // Keep the IMU interrupt from adding records at the same time.
+    giel = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    recorderAppend(record, sizeof(record));
+    INTCONbits.GIEL = giel;
+}
+
+
+void recorderTask(void){
+
+    static bool busy = false;   // card is programming buffers[write]
+    static uint8_t write;       // buffer being written
+    bool giel;
+
+    // Bring up the card first.
+    if (starting){
+        recorderStart();
+        return;
+    }
+
+    // Wait for the card to finish the last block, then free the buffer.
+    if (busy){
+        if (sdBusy()){
+            return;
+        }
+        busy = false;
+        full[write] = false;
+        return;
+    }
+
+    // Find a full buffer, the one not being filled is the older.
+    giel = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    write = fill ^ 1;
+    if (!full[write]){
+        write = fill;
+    }
+    INTCONbits.GIEL = giel;
+    if (!full[write]){
+        return;
+    }
+
+    // Start writing it, blocks the card rejects are dropped.
+    if (sdWriteBlock(blocks[write], buffers[write],
+                     RECORDER_BUFFER_SIZE)){
+        ++recorderBlocks;
+        busy = true;
+    } else {
+        ++recorderErrors;
+        full[write] = false;
+    }
+}
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////
+// File: sched.c
+// Header: sched.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "config.h"
+#include "stdint.h"
+#include "stdbool.h"
+#include "sched.h"
+
+
+// Timer 2 settings for a 1 millisecond tick, Fosc/4/prescale/125/5.
+#if PLLMUL == 4
+#define TMR2_PRESCALE 0b00000010    // 1:16
+#else
+#define TMR2_PRESCALE 0b00000001    // 1:4
+#endif
+#define TMR2_POSTSCALE 0b00100000   // 1:5
+#define TMR2_PERIOD 124
+
+
+// Task table.
+struct schedTask schedTasks[SCHED_MAX_TASKS];
+uint8_t schedTaskCount = 0;
+
+
+// Scheduler state.
+volatile uint16_t schedTickCount = 0;
+static void (*background)(void) = 0;
+
+
+void schedInit(void){
+
+    // Clear the task table.
+    schedTaskCount = 0;
+    background = 0;
+    schedTickCount = 0;
+
+    // Setup timer 2.
+    T2CON = TMR2_POSTSCALE | TMR2_PRESCALE;
+    PR2 = TMR2_PERIOD;
+    TMR2 = 0;
+
+    // Setup the tick interrupt.
+    IPR1bits.TMR2IP = 1;    // high priority
+    PIR1bits.TMR2IF = 0;
+    PIE1bits.TMR2IE = 1;
+
+    // Start the timer.
+    T2CONbits.TMR2ON = 1;
+}
+
+
+uint8_t schedAdd(void (*run)(void), uint16_t period, uint16_t deadline,
+                 uint16_t offset){
+
+    struct schedTask *task;
+
+    if (schedTaskCount >= SCHED_MAX_TASKS){
+        return SCHED_MAX_TASKS;
+    }
+
+    task = &schedTasks[schedTaskCount];
+    task->run = run;
+    task->period = period;
+    task->deadline = deadline;
+    task->release = schedTicks() + offset;
+    task->last = 0;
+    task->max = 0;
+    task->runs = 0;
+    task->overruns = 0;
+
+    return schedTaskCount++;
+}
+
+
+void schedBackground(void (*run)(void)){
+    background = run;
+}
+
+
+void schedRun(void){
+
+    uint8_t i;
+    uint16_t start, end;
+    struct schedTask *task;
+
+    while (true){
+
+        // Find the highest priority task that has been released.
+        start = schedTicks();
+        for (i = 0; i < schedTaskCount; ++i){
+            if ((int16_t)(start - schedTasks[i].release) >= 0){
+                break;
+            }
+        }
+
+        // Nothing is ready, use the slack.
+        if (i == schedTaskCount){
+            if (background){
+                background();
+            }
+            continue;
+        }
+
+        // Run the task.
+        task = &schedTasks[i];
+        task->run();
+        end = schedTicks();
+
+        // Update statistics.
+        task->last = end - start;
+        if (task->last > task->max){
+            task->max = task->last;
+        }
+        ++task->runs;
+        if ((uint16_t)(end - task->release) > task->deadline){
+            ++task->overruns;
+        }
+
+        // Schedule the next release, dropping any that have already
+        // been missed instead of running the task back to back.
+        do {
+            task->release += task->period;
+        } while ((int16_t)(end - task->release) > 0);
+    }
+}
+
+
+uint16_t schedTicks(void){
+
+    uint16_t t;
+    bool gie;
+
+    // Read the ticks atomically, this may be called before interrupts
+    // are enabled so restore the previous state instead of using ATOMIC.
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    t = schedTickCount;
+    INTCONbits.GIE = gie;
+
+    return t;
+}
+
+
+void schedClearStats(void){
+
+    uint8_t i;
+
+    for (i = 0; i < schedTaskCount; ++i){
+        schedTasks[i].last = 0;
+        schedTasks[i].max = 0;
+        schedTasks[i].runs = 0;
+        schedTasks[i].overruns = 0;
+    }
+}
+
+
+// Change temporary data section for library interrupts.
+#pragma tmpdata sched_tmpdata
+void schedISR(void){
+    SCHED_TICK_FLAG = 0;
+    ++schedTickCount;
+}
+#pragma tmpdata
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////
+// File: scroll.c
+// Header: scroll.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "graphics.h"
+#include "oled.h"
+#include "efis.h"
+#include "scroll.h"
+
+
+uint16_t scrollFrames = 0;
+uint16_t scrollScrolled = 0;
+
+
+// Last frame written and the start line it was written with.
+static struct efisFrame sent;
+static bool scrollable = false;
+static uint8_t line = 0;
+
+
+// Overlay and pitch line areas.
+static struct efisBox overlays[EFIS_OVERLAYS];
+static struct efisBox oldLines[EFIS_PITCH_LINES];
+static struct efisBox newLines[EFIS_PITCH_LINES];
+
+
+// Description:
+//      Write the rows of a screen area to the OLED as they are placed in
+//      display RAM by a start line.
+//
+// Input:
+//      uint8_t x0, x1:
+//          First and last column.
+//
+//      int16_t y0, y1:
+//          Bottom and top row in GL coordinates, clipped to the frame
+//          buffer.
+//
+//      uint8_t start:
+//          Start line.
+//
+static void __scrollArea(uint8_t x0, uint8_t x1,
+                         int16_t y0, int16_t y1, uint8_t start){
+
+    uint8_t r0, r1;
+
+    // Clip to the frame buffer.
+    if (y0 < GL_MIN_Y){
+        y0 = GL_MIN_Y;
+    }
+    if (y1 > GL_MAX_Y){
+        y1 = GL_MAX_Y;
+    }
+    if (y0 > y1){
+        return;
+    }
+
+    // Frame buffer rows count down from the top, display RAM rows are
+    // offset from them by the start line and wrap.
+    r0 = (GL_MAX_Y - y1 + start) & 0b00111111;
+    r1 = (GL_MAX_Y - y0 + start) & 0b00111111;
+    if (r0 <= r1){
+        oledWriteRows(x0, x1, r0 >> 3, r1 >> 3);
+    } else {
+        oledWriteRows(x0, x1, r0 >> 3, OLED_HEIGHT/8 - 1);
+        oledWriteRows(x0, x1, 0, r1 >> 3);
+    }
+}
+
+
+// Description:
+//      Write a box where it is in display RAM with a start line.
+//
+#define SCROLL_BOX(box, start) \
+    __scrollArea((box)->x0, (box)->x1, (box)->y0, (box)->y1, start)
+
+
+// Description:
+//      Write the pitch lines of one frame that are not in the other.
+//
+// Input:
+//      struct efisBox *lines, *others:
+//          Pitch lines of the frame and of the other frame.
+//
+//      uint8_t n, m:
+//          Number of lines and other lines.
+//
+//      int16_t d:
+//          Rows (GL coordinates) to add to the other frame's lines to
+//          line them up with this frame's.
+//
+//      uint8_t start:
+//          Start line of the frame.
+//
+static void __scrollLines(struct efisBox *lines, uint8_t n,
+                          struct efisBox *others, uint8_t m,
+                          int16_t d, uint8_t start){
+
+    uint8_t i, j;
+
+    for (i = 0; i < n; ++i){
+        for (j = 0; j < m; ++j){
+            if (lines[i].x0 == others[j].x0 &&
+                    lines[i].y0 == others[j].y0 + d){
+                break;
+            }
+        }
+        if (j == m){
+            SCROLL_BOX(&lines[i], start);
+        }
+    }
+}
+
+
+void scrollWrite(void){
+
+    struct efisFrame *frame = &efisFrame;
+    int16_t d;
+    uint8_t i, n, m, start;
+
+    ++scrollFrames;
+
+    // Pixels the image moved down.
+    d = frame->pitch - sent.pitch;
+
+    // Write the whole frame unless both frames are plain wings level
+    // frames a small pitch change apart.
+    if (!scrollable || !frame->level || frame->invalid ||
+            frame->layers != sent.layers ||
+            d > SCROLL_MAX_ROWS || d < -SCROLL_MAX_ROWS){
+        oledWriteBuffer();
+        line = 0;
+        sent = *frame;
+        scrollable = frame->level && !frame->invalid;
+        return;
+    }
+    ++scrollScrolled;
+
+    // Move the image already in display RAM down by d rows.
+    start = (line - d) & 0b00111111;
+    if (start != line){
+        oledSetStartLine(start);
+    }
+
+    // Rows scrolled in at the top (moving down) or bottom (moving up).
+    if (d > 0){
+        __scrollArea(GL_MIN_X, GL_MAX_X, GL_MAX_Y - d + 1, GL_MAX_Y, start);
+    } else if (d < 0){
+        __scrollArea(GL_MIN_X, GL_MAX_X, GL_MIN_Y, -d - 1, start);
+    }
+
+    // Overlays moved with the image, write them where they were and
+    // where they are now.
+    efisOverlays(overlays);
+    for (i = 0; i < EFIS_OVERLAYS; ++i){
+        if (d != 0){
+            SCROLL_BOX(&overlays[i], line);
+            SCROLL_BOX(&overlays[i], start);
+        } else if (i == EFIS_OVERLAY_COMPASS &&
+                   frame->heading != sent.heading){
+            SCROLL_BOX(&overlays[i], start);
+        }
+    }
+
+    // Pitch lines that came or went.
+    n = efisPitchLines(frame->pitch, frame->layers, newLines);
+    m = efisPitchLines(sent.pitch, sent.layers, oldLines);
+    __scrollLines(newLines, n, oldLines, m, -d, start);
+    __scrollLines(oldLines, m, newLines, n, d, line);
+
+    line = start;
+    sent = *frame;
+}
+
+
+void scrollInvalidate(void){
+    scrollable = false;
+}
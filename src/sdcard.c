@@ -0,0 +1,316 @@
+///////////////////////////////////////////////////////////////////////
+// File: sdcard.c
+// Header: sdcard.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "config.h"
+#include "stdint.h"
+#include "stdbool.h"
+#include "util.h"
+#include "spilib.h"
+#include "sdcard.h"
+#include "sched.h"
+#include "spitrace.h"
+
+
+// Commands.
+#define CMD0 0      // GO_IDLE_STATE
+#define CMD8 8      // SEND_IF_COND
+#define CMD16 16    // SET_BLOCKLEN
+#define CMD24 24    // WRITE_BLOCK
+#define CMD55 55    // APP_CMD
+#define CMD58 58    // READ_OCR
+#define ACMD41 41   // SD_SEND_OP_COND
+
+
+// R1 response flags.
+#define R1_IDLE 0x01
+#define R1_ILLEGAL 0x04
+
+
+// Data tokens.
+#define TOKEN_START_BLOCK 0xFE
+#define DATA_RESPONSE_MASK 0x1F
+#define DATA_ACCEPTED 0x05
+
+
+// Bring-up states (see sdInitStep).
+#define STATE_RESET 0   // clock the card and reset it into SPI mode
+#define STATE_CHECK 1   // find the card version
+#define STATE_WAKE 2    // wait for the card to leave the idle state
+#define STATE_SETUP 3   // find the addressing and set the block length
+#define STATE_READY 4
+#define STATE_FAILED 5
+
+
+// Milliseconds the card may take to leave the idle state.
+#define WAKE_TIMEOUT 1000
+
+
+// Card state.
+static uint8_t state = STATE_FAILED;
+static bool v2;                     // version 2 card
+static bool highCapacity = false;   // block addressed
+static uint16_t wakeStart;          // tick of the first wake up poll
+static uint16_t lastStep;           // tick of the last step
+
+
+// Decorator for selection of the card with low priority interrupts
+// (the IMU) off.  An extra byte is clocked after deselecting so the
+// card releases the data out line.
+#define SDC(code) do { \
+        bool giel = INTCONbits.GIEL; \
+        INTCONbits.GIEL = 0; \
+        SPI_TRACE_BEGIN(SPI_TRACE_SPI1); \
+        SDC_SELECT(); \
+        code \
+        SDC_DESELECT(); \
+        spi1ExchangeByte(0xFF); \
+        SPI_TRACE_END(SPI_TRACE_SPI1, SPI_TRACE_SDCARD, \
+                      SPI_TRACE_EXCHANGE); \
+        INTCONbits.GIEL = giel; \
+    } while (0)
+
+
+// Decorator for bring-up commands, SPI1 is clocked at Fosc/64 and then
+// returned to the IMU settings (see imuInit).  Only use inside SDC.
+#define SDC_SLOW(code) do { \
+        spi1Init(SPI_VALID_2ND_EDGE | SPI_ENABLE | SPI_IDLE_HIGH | \
+                 SPI_MASTER_FOSC_64, SPI_INT_DISABLE); \
+        code \
+        spi1Init(SPI_VALID_2ND_EDGE | SPI_ENABLE | SPI_IDLE_HIGH | \
+                 SPI_MASTER_FOSC_4, SPI_INT_DISABLE); \
+    } while (0)
+
+
+// Description:
+//      Send a command to the selected card and wait for the response.
+//
+// Input:
+//      uint8_t cmd:
+//          Command number.
+//
+//      uint32_t arg:
+//          Command argument.
+//
+//      uint8_t crc:
+//          CRC byte, only checked for CMD0 and CMD8.
+//
+// Output (uint8_t):
+//      R1 response, 0xFF if the card did not respond.
+//
+static uint8_t sdCommand(uint8_t cmd, uint32_t arg, uint8_t crc){
+
+    uint8_t i, r1;
+    union bytes4 a;
+
+    a.uint32 = arg;
+
+    // Send the command, argument is big endian.
+    spi1ExchangeByte(0xFF);
+    spi1ExchangeByte(0x40 | cmd);
+    spi1ExchangeByte(a.uint8D);
+    spi1ExchangeByte(a.uint8C);
+    spi1ExchangeByte(a.uint8B);
+    spi1ExchangeByte(a.uint8A);
+    spi1ExchangeByte(crc);
+
+    // The response comes within 8 bytes and starts with a zero bit.
+    for (i = 0; i < 8; ++i){
+        r1 = spi1ExchangeByte(0xFF);
+        if ((r1 & 0x80) == 0){
+            break;
+        }
+    }
+
+    return r1;
+}
+
+
+// Description:
+//      Take one step of bringing up the selected card.
+//
+// Input:
+//      uint16_t now:
+//          Scheduler ticks.
+//
+// Output (uint8_t):
+//      Next state.
+//
+static uint8_t sdBringUp(uint16_t now){
+
+    uint8_t i, r1;
+    uint8_t ocr[4];
+
+    switch (state){
+
+        // At least 74 clocks with the card deselected, then reset into
+        // SPI mode.
+        case STATE_RESET:
+            SDC_DESELECT();
+            for (i = 0; i < 10; ++i){
+                spi1ExchangeByte(0xFF);
+            }
+            SDC_SELECT();
+            for (i = 0; i < 10; ++i){
+                if (sdCommand(CMD0, 0, 0x95) == R1_IDLE){
+                    return STATE_CHECK;
+                }
+            }
+            return STATE_FAILED;
+
+        // Version 2 cards echo the check pattern, version 1 cards
+        // reject the command.
+        case STATE_CHECK:
+            r1 = sdCommand(CMD8, 0x000001AA, 0x87);
+            if (r1 == R1_IDLE){
+                for (i = 0; i < 4; ++i){
+                    ocr[i] = spi1ExchangeByte(0xFF);
+                }
+                if ((ocr[2] & 0x0F) != 0x01 || ocr[3] != 0xAA){
+                    return STATE_FAILED;
+                }
+                v2 = true;
+            } else if (r1 & R1_ILLEGAL){
+                v2 = false;
+            } else {
+                return STATE_FAILED;
+            }
+            wakeStart = now;
+            return STATE_WAKE;
+
+        // Ask the card to leave the idle state, announcing high
+        // capacity support to version 2 cards.
+        case STATE_WAKE:
+            sdCommand(CMD55, 0, 0x01);
+            r1 = sdCommand(ACMD41, v2 ? 0x40000000 : 0, 0x01);
+            if (r1 == 0){
+                return STATE_SETUP;
+            }
+            if (r1 != R1_IDLE || (uint16_t)(now - wakeStart) > WAKE_TIMEOUT){
+                return STATE_FAILED;
+            }
+            return STATE_WAKE;
+
+        // High capacity cards are block addressed, standard capacity
+        // cards need the block length set.
+        case STATE_SETUP:
+            highCapacity = false;
+            if (v2){
+                if (sdCommand(CMD58, 0, 0x01) != 0){
+                    return STATE_FAILED;
+                }
+                for (i = 0; i < 4; ++i){
+                    ocr[i] = spi1ExchangeByte(0xFF);
+                }
+                highCapacity = (ocr[0] & 0x40) != 0;
+            }
+            if (!highCapacity){
+                if (sdCommand(CMD16, SDC_BLOCK_SIZE, 0x01) != 0){
+                    return STATE_FAILED;
+                }
+            }
+            return STATE_READY;
+    }
+
+    return STATE_FAILED;
+}
+
+
+void sdInit(void){
+    state = STATE_RESET;
+    highCapacity = false;
+}
+
+
+uint8_t sdInitStep(void){
+
+    uint16_t now;
+
+    // Poll at most once a tick while the card wakes up.
+    if (state < STATE_READY){
+        now = schedTicks();
+        if (state == STATE_WAKE && now == lastStep){
+            return SDC_INIT_PENDING;
+        }
+        lastStep = now;
+        SDC(
+            SDC_SLOW(
+                state = sdBringUp(now);
+            );
+        );
+    }
+
+    if (state == STATE_READY){
+        return SDC_INIT_READY;
+    }
+    if (state == STATE_FAILED){
+        return SDC_INIT_FAILED;
+    }
+    return SDC_INIT_PENDING;
+}
+
+
+bool sdWriteBlock(uint32_t block, const uint8_t *data, uint16_t length){
+
+    uint16_t i;
+    uint8_t tmp, response;
+
+    // Standard capacity cards are byte addressed.
+    if (!highCapacity){
+        block <<= 9;
+    }
+
+    response = 0;
+    SDC(
+        if (sdCommand(CMD24, block, 0x01) == 0){
+
+            spi1ExchangeByte(0xFF);
+            spi1ExchangeByte(TOKEN_START_BLOCK);
+
+            // Send the data and pad the block with zeros, without the
+            // function call overhead of spi1ExchangeByte, the bus is
+            // known to be idle.
+            for (i = 0; i < length; ++i){
+                SPI1_BUFFER = data[i];
+                while (SPI1_RECEIVE_DONE == 0);
+                tmp = SPI1_BUFFER;
+            }
+            for (; i < SDC_BLOCK_SIZE; ++i){
+                SPI1_BUFFER = 0;
+                while (SPI1_RECEIVE_DONE == 0);
+                tmp = SPI1_BUFFER;
+            }
+
+            // Dummy CRC and data response.
+            spi1ExchangeByte(0xFF);
+            spi1ExchangeByte(0xFF);
+            response = spi1ExchangeByte(0xFF) & DATA_RESPONSE_MASK;
+        }
+    );
+
+    return response == DATA_ACCEPTED;
+}
+
+
+bool sdBusy(void){
+
+    uint8_t r;
+
+    // The card holds data out low while programming.
+    SDC(
+        r = spi1ExchangeByte(0xFF);
+    );
+
+    return r != 0xFF;
+}
@@ -15,6 +15,7 @@
 #include <p18cxxx.h>
 #include "stdint.h"
 #include "spilib.h"
+#include "spitrace.h"
 
 
 void spi1Init(uint8_t config, uint8_t interupt){
@@ -67,8 +68,10 @@ void spi2Init(uint8_t config, uint8_t interupt){
 // NOTE: Due o how macros work it cannot be commented.
 #define SPI1_EXCHANGE_BYTE do { \
         uint8_t tmp; \
+        SPI_TRACE_BYTE(SPI_TRACE_SPI1); \
         SPI1_BUFFER = out; \
         if (SPI1_WRITE_COLLISION){ \
+            SPI_TRACE_COLLISION(SPI_TRACE_SPI1); \
             while (SPI1_RECEIVE_DONE == 0); \
             SPI1_WRITE_COLLISION = 0; \
             tmp = SPI1_BUFFER; \
@@ -88,12 +91,15 @@ uint8_t spi2ExchangeByte(uint8_t out){
 
     uint8_t tmp;
 
+    SPI_TRACE_BYTE(SPI_TRACE_SPI2);
+
     // Transmit byte over SPI.
     SPI2_BUFFER = out;
 
     // If this cause a write collision wait for previous exchange to
     // finish and throw away the received byte.
     if (SPI2_WRITE_COLLISION){
+        SPI_TRACE_COLLISION(SPI_TRACE_SPI2);
         while (SPI2_RECEIVE_DONE == 0); // wait for receive to finish
         SPI2_WRITE_COLLISION = 0;       // clear write collision bit
         tmp = SPI2_BUFFER;              // empty buffer
@@ -168,3 +174,33 @@ void spi2Exchange(uint8_t len, uint8_t *outPtr, uint8_t *inPtr){
         }
     }
 }
+
+
+// Send a block over SPI2.  The next byte is fetched while the current
+// one shifts out and the received byte is read only to clear BF.
+#define SPI2_WRITE_BLOCK do { \
+        uint8_t tmp, next; \
+        if (len == 0){ \
+            return; \
+        } \
+        SPI_TRACE_BYTES(SPI_TRACE_SPI2, len); \
+        SPI2_BUFFER = *buf++; \
+        while (--len){ \
+            next = *buf++; \
+            while (SPI2_RECEIVE_DONE == 0); \
+            tmp = SPI2_BUFFER; \
+            SPI2_BUFFER = next; \
+        } \
+        while (SPI2_RECEIVE_DONE == 0); \
+        tmp = SPI2_BUFFER; \
+    } while (0)
+
+
+void spi2Write(const uint8_t *buf, uint16_t len){
+    SPI2_WRITE_BLOCK;
+}
+
+
+void spi2WriteROM(const rom uint8_t *buf, uint16_t len){
+    SPI2_WRITE_BLOCK;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////
+// File: spitrace.c
+// Header: spitrace.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "stdint.h"
+#include "stdbool.h"
+#include "util.h"
+#include "profile.h"
+#include "spitrace.h"
+
+
+#ifdef SPI_TRACE
+
+
+// Ring of finished transactions.
+static struct spiTraceRecord ring[SPI_TRACE_LENGTH];
+static uint8_t head = 0;    // next record to write
+static uint8_t count = 0;   // records in the ring
+
+
+// Open transaction of each bus.
+static uint16_t starts[SPI_TRACE_BUSES];
+uint16_t spiTraceBytes[SPI_TRACE_BUSES];
+uint8_t spiTraceCollisions[SPI_TRACE_BUSES];
+
+
+uint16_t spiTraceDrops = 0;
+
+
+void spiTraceInit(void){
+    profileInit();
+    head = 0;
+    count = 0;
+    spiTraceDrops = 0;
+}
+
+
+// Change temporary data section, also called from the IMU interrupt.
+#pragma tmpdata spitrace_tmpdata
+void spiTraceBegin(uint8_t bus){
+
+    union bytes2 t;
+    bool giel;
+
+    giel = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    t.uint8A = TMR1L;
+    t.uint8B = TMR1H;
+    starts[bus] = t.uint16;
+    spiTraceBytes[bus] = 0;
+    spiTraceCollisions[bus] = 0;
+    INTCONbits.GIEL = giel;
+}
+
+
+void spiTraceEnd(uint8_t bus, uint8_t device, uint8_t kind){
+
+    union bytes2 t;
+    struct spiTraceRecord *record;
+    bool giel;
+
+    giel = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    t.uint8A = TMR1L;
+    t.uint8B = TMR1H;
+    if (count == SPI_TRACE_LENGTH){
+        ++spiTraceDrops;
+    } else {
+        record = &ring[head];
+        record->device = bus << 4 | device;
+        record->kind = kind;
+        record->collisions = spiTraceCollisions[bus];
+        record->length = spiTraceBytes[bus];
+        record->start = starts[bus];
+        record->end = t.uint16;
+        if (++head == SPI_TRACE_LENGTH){
+            head = 0;
+        }
+        ++count;
+    }
+    INTCONbits.GIEL = giel;
+}
+#pragma tmpdata
+
+
+uint8_t spiTraceRead(struct spiTraceRecord *records, uint8_t max){
+
+    uint8_t i, tail;
+    bool giel;
+
+    // Hold off the IMU interrupt, it adds records.
+    giel = INTCONbits.GIEL;
+    INTCONbits.GIEL = 0;
+    if (max > count){
+        max = count;
+    }
+    tail = head + SPI_TRACE_LENGTH - count;
+    if (tail >= SPI_TRACE_LENGTH){
+        tail -= SPI_TRACE_LENGTH;
+    }
+    for (i = 0; i < max; ++i){
+        records[i] = ring[tail];
+        if (++tail == SPI_TRACE_LENGTH){
+            tail = 0;
+        }
+    }
+    count -= max;
+    INTCONbits.GIEL = giel;
+
+    return max;
+}
+
+
+#endif // SPI_TRACE
@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////
+// File: telemetry.c
+// Header: telemetry.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "config.h"
+#include "stdint.h"
+#include "stdbool.h"
+#include "util.h"
+#include "uart.h"
+#include "imu.h"
+#include "ahrs.h"
+#include "profile.h"
+#include "sched.h"
+#include "spitrace.h"
+#include "telemetry.h"
+
+
+// Frame being built.
+static uint8_t frame[TLM_HEADER_LENGTH + TLM_MAX_PAYLOAD + TLM_CRC_LENGTH];
+
+
+// Telemetry state.
+static uint8_t channelMask = 0;
+static uint8_t sequence = 0;
+uint16_t telemetryDrops = 0;
+
+
+// Description:
+//      Store a 16-bit value as two little endian bytes.
+//
+// Input:
+//      uint8_t *dst:
+//          Location to store value at.
+//
+//      uint16_t value:
+//          Value to store.
+//
+// Output (uint8_t *):
+//      Location after the stored value.
+//
+static uint8_t *put16(uint8_t *dst, uint16_t value){
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    return dst + 2;
+}
+
+
+// Description:
+//      Update a CRC-16-CCITT with a block of bytes.
+//
+// Input:
+//      uint16_t crc:
+//          CRC so far, 0xFFFF to start.
+//
+//      const uint8_t *data:
+//          Bytes to add to the CRC.
+//
+//      uint8_t length:
+//          Number of bytes.
+//
+// Output (uint16_t):
+//      Updated CRC.
+//
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint8_t length){
+
+    uint8_t i, bit;
+
+    for (i = 0; i < length; ++i){
+        crc ^= (uint16_t)data[i] << 8;
+        for (bit = 0; bit < 8; ++bit){
+            if (crc & 0x8000){
+                crc = (crc << 1) ^ 0x1021;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+
+    return crc;
+}
+
+
+void telemetryInit(uint8_t channels){
+    uartInit();
+    channelMask = channels;
+}
+
+
+bool telemetryEnabled(uint8_t channel){
+    return (channelMask & TLM_CHANNEL(channel)) != 0;
+}
+
+
+bool telemetrySend(uint8_t channel, const uint8_t *payload, uint8_t length){
+
+    uint8_t i, total;
+    uint16_t crc;
+
+    if (!telemetryEnabled(channel) || length > TLM_MAX_PAYLOAD){
+        return false;
+    }
+
+    // Header.
+    frame[0] = TLM_SYNC0;
+    frame[1] = TLM_SYNC1;
+    frame[2] = channel;
+    frame[3] = sequence;
+    frame[4] = length;
+
+    // Payload.
+    for (i = 0; i < length; ++i){
+        frame[TLM_HEADER_LENGTH + i] = payload[i];
+    }
+
+    // CRC, skipping the sync bytes.
+    total = TLM_HEADER_LENGTH + length;
+    crc = crc16(0xFFFF, &frame[2], total - 2);
+    put16(&frame[total], crc);
+    total += TLM_CRC_LENGTH;
+
+    // Queue the frame.  The sequence number counts dropped frames too
+    // so the receiver sees them as lost.
+    ++sequence;
+    if (!uartWrite(frame, total)){
+        ++telemetryDrops;
+        return false;
+    }
+
+    return true;
+}
+
+
+void telemetryRawImu(void){
+
+    int16_t payload[6];
+
+    if (!telemetryEnabled(TLM_RAW_IMU)){
+        return;
+    }
+
+    ATOMIC(
+        payload[0] = imuAccX[imuAccIdx].int16;
+        payload[1] = imuAccY[imuAccIdx].int16;
+        payload[2] = imuAccZ[imuAccIdx].int16;
+        payload[3] = imuMagX[imuMagIdx].int16;
+        payload[4] = imuMagY[imuMagIdx].int16;
+        payload[5] = imuMagZ[imuMagIdx].int16;
+    );
+
+    telemetrySend(TLM_RAW_IMU, (uint8_t *)payload, sizeof(payload));
+}
+
+
+void telemetryVectors(void){
+
+    int16_t payload[6];
+
+    if (!telemetryEnabled(TLM_VECTORS)){
+        return;
+    }
+
+    ahrsReadAcc(&payload[0], &payload[1], &payload[2]);
+    ahrsReadMag(&payload[3], &payload[4], &payload[5]);
+
+    telemetrySend(TLM_VECTORS, (uint8_t *)payload, sizeof(payload));
+}
+
+
+void telemetryAttitude(int16_t yaw, int16_t pitch, int16_t roll,
+                       bool valid){
+
+    uint8_t payload[7];
+    uint8_t *p;
+
+    if (!telemetryEnabled(TLM_ATTITUDE)){
+        return;
+    }
+
+    p = put16(payload, yaw);
+    p = put16(p, pitch);
+    p = put16(p, roll);
+    *p = valid;
+
+    telemetrySend(TLM_ATTITUDE, payload, sizeof(payload));
+}
+
+
+#ifdef PROFILE
+void telemetryProfile(void){
+
+    uint8_t i;
+    uint16_t mean;
+    uint8_t payload[6*PROFILE_SECTIONS];
+    uint8_t *p;
+    struct profileSection *section;
+
+    if (!telemetryEnabled(TLM_PROFILE)){
+        return;
+    }
+
+    p = payload;
+    for (i = 0; i < PROFILE_SECTIONS; ++i){
+        section = &profileSections[i];
+        mean = 0;
+        if (section->count > 0){
+            mean = section->sum/section->count;
+        }
+        p = put16(p, (uint16_t)profileToUs(mean));
+        p = put16(p, (uint16_t)profileToUs(section->max));
+        p = put16(p, section->count);
+    }
+
+    telemetrySend(TLM_PROFILE, payload, sizeof(payload));
+}
+#endif
+
+
+void telemetryStatus(uint16_t bootTime, int16_t headroom,
+                     int16_t headroomMin, uint8_t layers){
+
+    uint8_t i;
+    uint8_t payload[9 + 4*SCHED_MAX_TASKS];
+    uint8_t *p;
+
+    if (!telemetryEnabled(TLM_STATUS)){
+        return;
+    }
+
+    p = put16(payload, bootTime);
+    p = put16(p, headroom);
+    p = put16(p, headroomMin);
+    *p++ = layers;
+    p = put16(p, telemetryDrops);
+    for (i = 0; i < schedTaskCount; ++i){
+        p = put16(p, schedTasks[i].max);
+        p = put16(p, schedTasks[i].overruns);
+    }
+
+    telemetrySend(TLM_STATUS, payload, p - payload);
+}
+
+
+#ifdef SPI_TRACE
+void telemetrySpiTrace(void){
+
+    uint8_t i, frames, count;
+    uint8_t payload[2 + 9*TLM_SPI_TRACE_RECORDS];
+    uint8_t *p;
+    struct spiTraceRecord records[TLM_SPI_TRACE_RECORDS];
+    struct spiTraceRecord *record;
+
+    if (!telemetryEnabled(TLM_SPI_TRACE)){
+        return;
+    }
+
+    for (frames = 0; frames < TLM_SPI_TRACE_FRAMES; ++frames){
+        count = spiTraceRead(records, TLM_SPI_TRACE_RECORDS);
+        if (count == 0){
+            return;
+        }
+        p = put16(payload, spiTraceDrops);
+        for (i = 0; i < count; ++i){
+            record = &records[i];
+            *p++ = record->device;
+            *p++ = record->kind;
+            *p++ = record->collisions;
+            p = put16(p, record->length);
+            p = put16(p, record->start);
+            p = put16(p, record->end);
+        }
+        telemetrySend(TLM_SPI_TRACE, payload, p - payload);
+    }
+}
+#endif
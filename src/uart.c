@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////
+// File: uart.c
+// Header: uart.h
+// Author: Michael R. Shannon
+// Written: Monday, October 19, 2026
+// Updated: Monday, October 19, 2026
+// Device: PIC18F87K22
+// Compiler: C18
+//
+// See header file for documentation.
+//
+////////////////////////////////////////////////////////////////////////
+
+
+#include <p18cxxx.h>
+#include "config.h"
+#include "stdint.h"
+#include "stdbool.h"
+#include "uart.h"
+
+
+// Baud rate generator value for 16-bit, high speed mode, Fosc/4/(n+1).
+#define UART_BRG ((2500000L*PLLMUL + UART_BAUD/2)/UART_BAUD - 1)
+
+
+// Ring buffer index mask.
+#define MASK (UART_TX_BUFFER_LENGTH - 1)
+
+
+// Transmit ring buffer.  The head is only written by uartWrite and the
+// tail only by the interrupt.
+static uint8_t txBuffer[UART_TX_BUFFER_LENGTH];
+static volatile uint8_t txHead = 0;    // next location to write
+static volatile uint8_t txTail = 0;    // next location to send
+
+
+void uartInit(void){
+
+    txHead = 0;
+    txTail = 0;
+
+    // Setup pins.
+    TRISCbits.TRISC6 = 0;   // TX1 as output
+    TRISCbits.TRISC7 = 1;   // RX1 as input
+
+    // Setup baud rate generator.
+    BAUDCON1bits.BRG16 = 1;
+    TXSTA1bits.BRGH = 1;
+    SPBRGH1 = (uint8_t)(UART_BRG >> 8);
+    SPBRG1 = (uint8_t)UART_BRG;
+
+    // Asynchronous transmit only.
+    TXSTA1bits.SYNC = 0;
+    RCSTA1bits.SPEN = 1;
+    TXSTA1bits.TXEN = 1;
+
+    // Low priority transmit interrupt, enabled when there is data.
+    IPR1bits.TX1IP = 0;
+    UART_TX_INT_ENABLE = 0;
+}
+
+
+uint8_t uartFree(void){
+    return (uint8_t)(txTail - txHead - 1) & MASK;
+}
+
+
+bool uartWrite(const uint8_t *data, uint8_t length){
+
+    uint8_t i, head;
+
+    if (length > uartFree()){
+        return false;
+    }
+
+    // Copy data into the buffer, the interrupt can not see it until the
+    // head is moved.
+    head = txHead;
+    for (i = 0; i < length; ++i){
+        txBuffer[head] = data[i];
+        head = (head + 1) & MASK;
+    }
+    txHead = head;
+
+    // Start sending.
+    UART_TX_INT_ENABLE = 1;
+
+    return true;
+}
+
+
+// Change temporary data section for library interrupts.
+#pragma tmpdata uart_tmpdata
+void uartISR(void){
+
+    // Turn the interrupt off when there is nothing left to send.
+    if (txTail == txHead){
+        UART_TX_INT_ENABLE = 0;
+        return;
+    }
+
+    // Send the next byte, this clears the interrupt flag.
+    TXREG1 = txBuffer[txTail];
+    txTail = (txTail + 1) & MASK;
+}
+#pragma tmpdata